@@ -0,0 +1,103 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Additions of quantities expressed in units with an awkward common unit (`ft` and `m` have the common unit of
+// `m / 1250`) performed with `operator+` (which scales both operands to the common unit) and with `add` using
+// the result unit policies (which scale at most one operand).
+
+#include "runtime_benchmark.h"
+#include <mp-units/systems/international/international.h>
+#include <mp-units/systems/si/si.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace mp_units;
+
+namespace {
+
+constexpr long size = 1 << 20;
+
+std::vector<double> random_values(unsigned seed)
+{
+  std::mt19937_64 gen(seed);
+  std::uniform_real_distribution<double> dist(-1000., 1000.);
+  std::vector<double> values(size);
+  std::ranges::generate(values, [&] { return dist(gen); });
+  return values;
+}
+
+}  // namespace
+
+int main()
+{
+  std::vector<quantity<si::metre, double>> metres;
+  std::vector<quantity<international::foot, double>> feet;
+  for (double v : random_values(1)) metres.push_back(v * si::metre);
+  for (double v : random_values(2)) feet.push_back(v * international::foot);
+
+  // accumulation of `m` into a `ft` accumulator
+  benchmark::run("accumulate operator+", size, [&] {
+    quantity<international::foot, double> acc = 0. * international::foot;
+    for (const auto& q : metres) acc = acc + q;
+    return acc;
+  });
+  benchmark::run("accumulate operator+=", size, [&] {
+    quantity<international::foot, double> acc = 0. * international::foot;
+    for (const auto& q : metres) acc += q;
+    return acc;
+  });
+  benchmark::run("accumulate add<lhs>", size, [&] {
+    quantity<international::foot, double> acc = 0. * international::foot;
+    for (const auto& q : metres) acc = add<result_unit::lhs>(acc, q);
+    return acc;
+  });
+
+  // accumulation of `km` into a `m` accumulator (an integral factor)
+  std::vector<quantity<si::kilo<si::metre>, std::int64_t>> kilometres;
+  for (double v : random_values(3)) kilometres.push_back(static_cast<std::int64_t>(v) * si::kilo<si::metre>);
+  benchmark::run("accumulate int64 operator+", size, [&] {
+    quantity<si::metre, std::int64_t> acc = 0 * si::metre;
+    for (const auto& q : kilometres) acc = acc + q;
+    return acc;
+  });
+  benchmark::run("accumulate int64 add<fewest_scalings>", size, [&] {
+    quantity<si::metre, std::int64_t> acc = 0 * si::metre;
+    for (const auto& q : kilometres) acc = add<result_unit::fewest_scalings>(acc, q);
+    return acc;
+  });
+
+  // element-wise sums of mixed units
+  std::vector<quantity<international::foot, double>> out(size);
+  benchmark::run("element-wise operator+", size, [&] {
+    std::ranges::transform(feet, metres, out.begin(), [](const auto& a, const auto& b) {
+      return quantity<international::foot, double>(a + b);
+    });
+    return out.back();
+  });
+  benchmark::run("element-wise add<fewest_scalings>", size, [&] {
+    std::ranges::transform(feet, metres, out.begin(),
+                           [](const auto& a, const auto& b) { return add<result_unit::fewest_scalings>(a, b); });
+    return out.back();
+  });
+}
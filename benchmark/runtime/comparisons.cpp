@@ -0,0 +1,119 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Comparisons of quantities expressed in units with an awkward common unit (`ft` and `m` have the common unit of
+// `m / 1250`) performed with the `quantity` operators and with an explicit conversion to the common quantity type
+// (which is what the operators did before and which overflows for large `int64` values).
+
+#include "runtime_benchmark.h"
+#include <mp-units/systems/international/international.h>
+#include <mp-units/systems/si/si.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace mp_units;
+
+namespace {
+
+constexpr long size = 1 << 20;
+
+struct common_type_less {
+  template<Quantity Q1, Quantity Q2>
+  bool operator()(const Q1& lhs, const Q2& rhs) const
+  {
+    using ct = std::common_type_t<Q1, Q2>;
+    return (ct(lhs).numerical_value() <=> ct(rhs).numerical_value()) < 0;
+  }
+};
+
+template<typename Rep>
+std::vector<Rep> random_values(unsigned seed)
+{
+  std::mt19937_64 gen(seed);
+  std::vector<Rep> values(size);
+  if constexpr (std::is_integral_v<Rep>) {
+    std::uniform_int_distribution<Rep> dist(-1'000'000'000, 1'000'000'000);
+    std::ranges::generate(values, [&] { return dist(gen); });
+  } else {
+    std::uniform_real_distribution<Rep> dist(-1e9, 1e9);
+    std::ranges::generate(values, [&] { return dist(gen); });
+  }
+  return values;
+}
+
+template<typename Rep, typename Less>
+void run_all(const std::string& name, Less less)
+{
+  std::vector<quantity<international::foot, Rep>> feet;
+  std::vector<quantity<si::metre, Rep>> metres;
+  for (Rep v : random_values<Rep>(1)) feet.push_back(v * international::foot);
+  for (Rep v : random_values<Rep>(2)) metres.push_back(v * si::metre);
+
+  // sort the data by comparing every element with a pivot in the other unit
+  benchmark::run(name + " partition", size, [&] {
+    auto data = feet;
+    auto it = data.begin();
+    for (auto pivot : {-5e8, 0., 5e8}) {
+      const auto p = static_cast<Rep>(pivot) * si::metre;
+      it = std::partition(it, data.end(), [&](const auto& q) { return less(q, p); });
+    }
+    return data.front();
+  });
+
+  std::ranges::sort(feet);
+  std::ranges::sort(metres);
+
+  // binary search of the keys in the other unit
+  benchmark::run(name + " lower_bound", size, [&] {
+    long sum = 0;
+    for (const auto& key : metres)
+      sum += std::lower_bound(feet.begin(), feet.end(), key, less) - feet.begin();
+    return sum;
+  });
+
+  // the order of a merge of two sorted ranges
+  benchmark::run(name + " merge", size, [&] {
+    long taken = 0;
+    auto f = feet.begin();
+    for (auto m = metres.begin(); f != feet.end() && m != metres.end();) {
+      if (less(*m, *f))
+        ++m;
+      else
+        ++f, ++taken;
+    }
+    return taken;
+  });
+}
+
+}  // namespace
+
+int main()
+{
+  run_all<std::int64_t>("int64 operator<", std::less<>{});
+  run_all<std::int64_t>("int64 common type", common_type_less{});
+  run_all<double>("double operator<", std::less<>{});
+  run_all<double>("double common type", common_type_less{});
+}
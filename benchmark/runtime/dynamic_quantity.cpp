@@ -0,0 +1,93 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// A mixed workload of distances and durations with units known only at runtime (as they come from configuration
+// files or RPC messages) processed with `dynamic_quantity` and with static quantities of fixed units.
+
+#include "runtime_benchmark.h"
+#include <mp-units/systems/international/international.h>
+#include <mp-units/systems/si/dynamic_quantity.h>
+#include <mp-units/systems/si/si.h>
+#include <array>
+#include <random>
+#include <vector>
+
+using namespace mp_units;
+
+namespace {
+
+constexpr long size = 1 << 20;
+
+}  // namespace
+
+int main()
+{
+  using si::dynamic_quantity;
+  using si::dynamic_unit;
+  const std::array<dynamic_unit, 4> distance_units = {si::metre, si::kilo<si::metre>, international::foot,
+                                                      international::mile};
+  const std::array<dynamic_unit, 3> duration_units = {si::second, si::minute, si::hour};
+
+  std::mt19937_64 gen(1);
+  std::uniform_real_distribution<double> dist(1., 100.);
+  std::uniform_int_distribution<std::size_t> pick(0, 11);
+  std::vector<dynamic_quantity<>> distances, durations;
+  std::vector<quantity<si::metre>> static_distances;
+  std::vector<quantity<si::second>> static_durations;
+  for (long i = 0; i < size; ++i) {
+    const std::size_t p = pick(gen);
+    distances.emplace_back(dist(gen), distance_units[p % 4]);
+    durations.emplace_back(dist(gen), duration_units[p % 3]);
+    static_distances.push_back(distances.back().as<si::metre>());
+    static_durations.push_back(durations.back().as<si::second>());
+  }
+
+  constexpr auto kmph = si::kilo<si::metre> / si::hour;
+  benchmark::run("static speed", size, [&] {
+    quantity<kmph> total = 0. * kmph;
+    for (long i = 0; i < size; ++i) total += static_distances[i] / static_durations[i];
+    return total;
+  });
+  benchmark::run("dynamic speed", size, [&] {
+    quantity<kmph> total = 0. * kmph;
+    for (long i = 0; i < size; ++i) total += (distances[i] / durations[i]).as<kmph>();
+    return total;
+  });
+  benchmark::run("dynamic speed with a dimension check", size, [&] {
+    quantity<kmph> total = 0. * kmph;
+    for (long i = 0; i < size; ++i) {
+      const auto speed = distances[i] / durations[i];
+      if (speed.convertible_to<kmph>()) total += speed.as<kmph>();
+    }
+    return total;
+  });
+  benchmark::run("static sum", size, [&] {
+    quantity<si::metre> total = 0. * si::metre;
+    for (const auto& d : static_distances) total += d;
+    return total;
+  });
+  benchmark::run("dynamic sum", size, [&] {
+    dynamic_quantity<> total(0., si::metre);
+    for (const auto& d : distances) total = total + d;
+    return total.numerical_value();
+  });
+}
@@ -0,0 +1,92 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Explicit Euler integration steps of a set of particles with velocities in `km/h`, accelerations in `m/s²`,
+// positions in `m`, and a time step in `ms` (every step converts units) performed with `double`, `std::int64_t`,
+// and fixed-point representation types.
+
+#include "runtime_benchmark.h"
+#include <mp-units/fixed_point.h>
+#include <mp-units/systems/si/si.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace mp_units;
+
+namespace {
+
+constexpr long size = 1 << 16;
+constexpr int steps = 16;
+
+constexpr auto km_per_h = si::kilo<si::metre> / si::hour;
+constexpr auto m_per_s2 = si::metre / square(si::second);
+
+template<typename Rep>
+struct particles {
+  std::vector<quantity<si::metre, Rep>> position;
+  std::vector<quantity<km_per_h, Rep>> velocity;
+  std::vector<quantity<m_per_s2, Rep>> acceleration;
+};
+
+// accelerations and velocities of the same values for all the representation types
+template<typename Rep>
+particles<Rep> make_particles()
+{
+  std::mt19937_64 gen(1);
+  std::uniform_int_distribution<int> dist(-100, 100);
+  particles<Rep> res;
+  for (long i = 0; i < size; ++i) {
+    res.position.push_back(Rep(0) * si::metre);
+    res.velocity.push_back(Rep(dist(gen)) * km_per_h);
+    res.acceleration.push_back(Rep(dist(gen) / 10) * m_per_s2);
+  }
+  return res;
+}
+
+template<typename Rep>
+auto integrate(particles<Rep>& p, quantity<si::milli<si::second>, Rep> dt)
+{
+  for (int s = 0; s < steps; ++s)
+    for (long i = 0; i < size; ++i) {
+      p.velocity[i] += value_cast<km_per_h>(p.acceleration[i] * dt);
+      p.position[i] += value_cast<si::metre>(p.velocity[i] * dt);
+    }
+  return p.position[size / 2];
+}
+
+template<typename Rep>
+void run(std::string_view name)
+{
+  auto p = make_particles<Rep>();
+  benchmark::run(name, size * steps, [&] { return integrate(p, Rep(10) * si::milli<si::second>); });
+}
+
+}  // namespace
+
+int main()
+{
+  run<double>("double");
+  run<std::int64_t>("std::int64_t");
+  run<fixed<std::int32_t, 16>>("fixed<std::int32_t, 16>");
+  run<fixed<std::int64_t, 32>>("fixed<std::int64_t, 32>");
+}
@@ -0,0 +1,101 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// The memory footprint of the columns of quantities with `float`, `float16`, and `bfloat16` representation types,
+// the throughput of the element-wise and bulk conversions between them, and the one of summing (with the SIMD
+// kernels) a column stored in 16 bits and widened in blocks compared to summing a `float` column.
+
+#include "runtime_benchmark.h"
+#include <mp-units/float16.h>
+#include <mp-units/numeric.h>
+#include <mp-units/systems/si/si.h>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mp_units;
+
+namespace {
+
+// larger than the last level caches, so the summing is bound by the memory bandwidth
+constexpr long size = 1 << 24;
+constexpr long block = 1024;
+
+std::vector<float> random_values()
+{
+  std::mt19937_64 gen(1);
+  std::uniform_real_distribution<float> dist(-1000.f, 1000.f);
+  std::vector<float> values(size);
+  for (auto& v : values) v = dist(gen);
+  return values;
+}
+
+template<typename Rep>
+void run(const std::string& name, const std::vector<float>& values)
+{
+  std::vector<Rep> compact(size);
+  std::vector<float> wide(size);
+  const auto f = make_quantity_span<si::metre>(values);
+  const auto c = make_quantity_span<si::metre>(compact);
+  const auto w = make_quantity_span<si::metre>(wide);
+  std::printf("%-50s %12zu bytes\n", (name + " column").c_str(), compact.size() * sizeof(Rep));
+
+  using q = quantity<si::metre, float>;
+  benchmark::run(name + " narrow (element-wise)", size, [&] {
+    for (long i = 0; i < size; ++i) c[i] = value_cast<Rep>(q(f[i]));
+    return compact[size / 2];
+  });
+  benchmark::run(name + " narrow (bulk)", size, [&] {
+    narrow(f, c);
+    return compact[size / 2];
+  });
+  benchmark::run(name + " widen (element-wise)", size, [&] {
+    for (long i = 0; i < size; ++i) w[i] = value_cast<float>(quantity<si::metre, Rep>(c[i]));
+    return wide[size / 2];
+  });
+  benchmark::run(name + " widen (bulk)", size, [&] {
+    widen(make_quantity_span<si::metre>(std::as_const(compact)), w);
+    return wide[size / 2];
+  });
+  benchmark::run(name + " sum (widened in blocks)", size, [&] {
+    std::vector<float> buffer(block);
+    const auto b = make_quantity_span<si::metre>(buffer);
+    quantity<si::metre, float> res = 0 * si::metre;
+    for (long i = 0; i < size; i += block) {
+      widen(make_quantity_span<si::metre>(std::as_const(compact).data() + i, block), b);
+      res += sum<summation::naive>(b);
+    }
+    return res;
+  });
+}
+
+}  // namespace
+
+int main()
+{
+  const auto values = random_values();
+  std::printf("%-50s %12zu bytes\n", "float column", values.size() * sizeof(float));
+  benchmark::run("float sum", size, [&] { return sum<summation::naive>(make_quantity_span<si::metre>(values)); });
+  run<float16>("float16", values);
+  run<bfloat16>("bfloat16", values);
+}
@@ -0,0 +1,99 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Parsing of quantities with `from_chars`: into a quantity of the unit found in the text (the fast path), into
+// a quantity of another unit of the same dimension (a lookup of every term and a scaling), and into a value with
+// a unit known only at runtime. Parsing of the number alone with `std::from_chars` is measured as a reference.
+
+#include "runtime_benchmark.h"
+#include <mp-units/systems/si/from_chars.h>
+#include <mp-units/systems/si/si.h>
+#include <charconv>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+using namespace mp_units;
+
+namespace {
+
+constexpr long size = 1 << 16;
+
+std::vector<std::string> random_texts(std::string_view unit)
+{
+  std::mt19937_64 gen(1);
+  std::uniform_real_distribution<double> dist(-1e6, 1e6);
+  std::vector<std::string> texts(size);
+  for (auto& text : texts) {
+    char buf[32];
+    const auto res = std::to_chars(buf, buf + sizeof(buf), dist(gen));
+    text.assign(buf, res.ptr).append(" ").append(unit);
+  }
+  return texts;
+}
+
+template<typename T>
+void run(const std::string& name, const std::vector<std::string>& texts)
+{
+  benchmark::run(name, size, [&] {
+    T result{};
+    int failures = 0;
+    for (const auto& text : texts)
+      if (mp_units::from_chars(text.data(), text.data() + text.size(), result).ec != std::errc{}) ++failures;
+    return failures;
+  });
+}
+
+}  // namespace
+
+int main()
+{
+  const auto speeds = random_texts("km/h");
+  benchmark::run("std::from_chars number only", size, [&] {
+    double result{};
+    int failures = 0;
+    for (const auto& text : speeds)
+      if (std::from_chars(text.data(), text.data() + text.size(), result).ec != std::errc{}) ++failures;
+    return failures;
+  });
+  run<quantity<si::kilo<si::metre> / si::hour>>("km/h to km/h", speeds);
+  run<quantity<si::metre / si::second>>("km/h to m/s", speeds);
+
+  const auto pressures = random_texts("kg m⁻¹ s⁻²");
+  run<quantity<si::pascal>>("kg m-1 s-2 (superscripts) to Pa", pressures);
+  const auto energies = random_texts("kg^1 m^2/(s^2 mol)");
+  run<quantity<si::joule / si::mole>>("kg^1 m^2/(s^2 mol) to J/mol", energies);
+
+  for (const auto& [name, texts] : {std::pair{"km/h", &speeds}, std::pair{"kg m-1 s-2 (superscripts)", &pressures},
+                                     std::pair{"kg^1 m^2/(s^2 mol)", &energies}})
+    benchmark::run(std::string("runtime unit ") + name, size, [&] {
+      double value{};
+      si::runtime_unit unit;
+      int failures = 0;
+      for (const auto& text : *texts)
+        if (from_chars(text.data(), text.data() + text.size(), value, unit).ec != std::errc{}) ++failures;
+      return failures;
+    });
+}
@@ -0,0 +1,94 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Output of quantities padded to the stream width (`std::setw`) performed with `operator<<` (which pads directly on
+// the stream) and with an intermediate `std::ostringstream` (which is what `operator<<` did before and still does
+// for other representation types). The output without padding is measured as a reference.
+
+#include "runtime_benchmark.h"
+#include <mp-units/ostream.h>
+#include <mp-units/systems/si/si.h>
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace mp_units;
+
+namespace {
+
+constexpr long size = 1 << 16;
+
+template<typename Q>
+void to_stream_via_string(std::ostream& os, const Q& q)
+{
+  std::ostringstream oss;
+  oss.flags(os.flags());
+  oss.imbue(os.getloc());
+  oss.precision(os.precision());
+  detail::to_stream(oss, q);
+  os << std::move(oss).str();
+}
+
+template<typename Rep>
+void run_all(const std::string& name)
+{
+  std::mt19937_64 gen(1);
+  std::uniform_real_distribution<double> dist(-1e6, 1e6);
+  std::vector<quantity<si::kilo<si::metre>, Rep>> values(size);
+  std::ranges::generate(values, [&] { return static_cast<Rep>(dist(gen)) * si::kilo<si::metre>; });
+
+  // the buffer of the stream is reused, so only the formatting is measured
+  std::ostringstream os;
+  const auto print_all = [&](auto print) {
+    return [&, print] {
+      os.seekp(0);
+      for (const auto& q : values) print(q);
+      return os.tellp();
+    };
+  };
+
+  benchmark::run(name + " no padding", size, print_all([&](const auto& q) { os << q; }));
+  benchmark::run(name + " setw operator<<", size, print_all([&](const auto& q) { os << std::setw(20) << q; }));
+  benchmark::run(name + " setw ostringstream", size, print_all([&](const auto& q) {
+                   os << std::setw(20);
+                   to_stream_via_string(os, q);
+                 }));
+  benchmark::run(name + " left setw operator<<", size,
+                 print_all([&](const auto& q) { os << std::left << std::setw(20) << q << std::right; }));
+  benchmark::run(name + " left setw ostringstream", size, print_all([&](const auto& q) {
+                   os << std::left << std::setw(20);
+                   to_stream_via_string(os, q);
+                   os << std::right;
+                 }));
+}
+
+}  // namespace
+
+int main()
+{
+  run_all<std::int64_t>("int64");
+  run_all<double>("double");
+}
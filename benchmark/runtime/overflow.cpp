@@ -0,0 +1,90 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Batch additions and unit conversions of quantities with 16- and 32-bit integral representation types that wrap
+// around on overflow (the unchecked baseline), saturate, or throw.
+
+#include "runtime_benchmark.h"
+#include <mp-units/overflow.h>
+#include <mp-units/systems/si/si.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mp_units;
+
+namespace {
+
+constexpr long size = 1 << 20;
+
+template<typename Rep, typename T>
+std::vector<Rep> random_values(unsigned seed)
+{
+  std::mt19937_64 gen(seed);
+  // small enough not to overflow in the additions and scaling by 10, so `checked` does not throw
+  std::uniform_int_distribution<T> dist(std::numeric_limits<T>::min() / 16, std::numeric_limits<T>::max() / 16);
+  std::vector<Rep> values(size);
+  for (auto& v : values) v = Rep(dist(gen));
+  return values;
+}
+
+template<typename Rep, typename T>
+void run(const std::string& name)
+{
+  const auto lhs = random_values<Rep, T>(1);
+  const auto rhs = random_values<Rep, T>(2);
+  std::vector<Rep> out(size);
+  const auto a = make_quantity_span<si::metre>(lhs);
+  const auto b = make_quantity_span<si::metre>(rhs);
+  const auto res = make_quantity_span<si::metre>(out);
+
+  using q = quantity<si::metre, Rep>;
+  benchmark::run(name + " operator+", size, [&] {
+    for (long i = 0; i < size; ++i) res[i] = q(a[i]) + q(b[i]);
+    return out[size / 2];
+  });
+  if constexpr (requires { add_sat(a, b, res); })
+    benchmark::run(name + " add_sat", size, [&] {
+      add_sat(a, b, res);
+      return out[size / 2];
+    });
+  // the scaling by a rational magnitude (`cm` to `mm`) and the range check of the result
+  const auto centimetres = make_quantity_span<si::centi<si::metre>>(lhs);
+  const auto millimetres = make_quantity_span<si::milli<si::metre>>(out);
+  benchmark::run(name + " value_cast", size, [&] {
+    value_cast<si::milli<si::metre>>(centimetres, millimetres.begin());
+    return out[size / 2];
+  });
+}
+
+}  // namespace
+
+int main()
+{
+  run<std::int16_t, std::int16_t>("int16_t");
+  run<saturating<std::int16_t>, std::int16_t>("saturating<int16_t>");
+  run<checked<std::int16_t>, std::int16_t>("checked<int16_t>");
+  run<std::int32_t, std::int32_t>("int32_t");
+  run<saturating<std::int32_t>, std::int32_t>("saturating<int32_t>");
+  run<checked<std::int32_t>, std::int32_t>("checked<int32_t>");
+}
@@ -0,0 +1,84 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Reductions of ranges of quantities compared with the same loops over raw `float` and `double` values.
+
+#include "runtime_benchmark.h"
+#include <mp-units/parallel_numeric.h>
+#include <mp-units/quantity_span.h>
+#include <mp-units/systems/si/si.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mp_units;
+
+namespace {
+
+constexpr long size = 1 << 22;
+
+template<typename T>
+void run_all(const std::string& name)
+{
+  std::mt19937_64 gen(1);
+  std::uniform_real_distribution<T> dist(-1., 1.);
+  std::vector<T> raw(size);
+  std::ranges::generate(raw, [&] { return dist(gen); });
+  std::vector<quantity<si::joule, T>> energies;
+  for (T v : raw) energies.push_back(v * si::joule);
+  const auto span = make_quantity_span<si::joule>(raw.data(), raw.size());
+
+  benchmark::run(name + " raw std::accumulate", size, [&] { return std::accumulate(raw.begin(), raw.end(), T{}); });
+  benchmark::run(name + " raw std::reduce", size, [&] { return std::reduce(raw.begin(), raw.end(), T{}); });
+  benchmark::run(name + " vector std::accumulate", size,
+                 [&] { return std::accumulate(energies.begin(), energies.end(), T{} * si::joule); });
+  benchmark::run(name + " vector sum<naive>", size, [&] { return sum<summation::naive>(energies); });
+  benchmark::run(name + " vector sum<neumaier>", size, [&] { return sum<summation::neumaier>(energies); });
+  benchmark::run(name + " span sum<naive>", size, [&] { return sum<summation::naive>(span); });
+  benchmark::run(name + " span sum<kahan>", size, [&] { return sum<summation::kahan>(span); });
+  benchmark::run(name + " span sum<neumaier>", size, [&] { return sum<summation::neumaier>(span); });
+  benchmark::run(name + " span sum<pairwise>", size, [&] { return sum<summation::pairwise>(span); });
+#ifdef __cpp_lib_execution
+  benchmark::run(name + " span sum(par_unseq)", size, [&] { return sum(std::execution::par_unseq, span); });
+#endif
+  benchmark::run(name + " raw inner_product", size,
+                 [&] { return std::inner_product(raw.begin(), raw.end(), raw.begin(), T{}); });
+  benchmark::run(name + " span dot<naive>", size, [&] { return dot<summation::naive>(span, span); });
+  benchmark::run(name + " raw minmax_element", size, [&] {
+    const auto [min, max] = std::minmax_element(raw.begin(), raw.end());
+    return *max - *min;
+  });
+  benchmark::run(name + " span min_max", size, [&] {
+    const auto [min, max] = min_max(span);
+    return max - min;
+  });
+}
+
+}  // namespace
+
+int main()
+{
+  run_all<float>("float");
+  run_all<double>("double");
+}
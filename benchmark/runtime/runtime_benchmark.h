@@ -0,0 +1,67 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <string_view>
+
+namespace mp_units::benchmark {
+
+/**
+ * @brief Prevents the compiler from optimizing away the computation of `value`
+ */
+template<typename T>
+inline void do_not_optimize(const T& value)
+{
+#if defined __GNUC__ || defined __clang__
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const T* sink;
+  sink = &value;
+#endif
+}
+
+/**
+ * @brief Prints the best wall time out of `repetitions` invocations of `f`
+ *
+ * @param name the label of the measurement
+ * @param items the number of items processed by one invocation (the time per item is printed as well)
+ */
+template<typename F>
+void run(std::string_view name, long items, F f, int repetitions = 10)
+{
+  using clock = std::chrono::steady_clock;
+  auto best = clock::duration::max();
+  for (int i = 0; i < repetitions; ++i) {
+    const auto start = clock::now();
+    do_not_optimize(f());
+    best = std::min(best, clock::now() - start);
+  }
+  const double ns = std::chrono::duration<double, std::nano>(best).count();
+  std::printf("%-50.*s %12.0f ns %8.2f ns/item\n", static_cast<int>(name.size()), name.data(), ns, ns / items);
+}
+
+}  // namespace mp_units::benchmark
@@ -0,0 +1,84 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Lookups of unit symbols (as parsed from configuration files or RPC messages) in the compile-time perfect hash
+// of `unit_registry` and in a `std::unordered_map` with the same content built at startup.
+
+#include "runtime_benchmark.h"
+#include <mp-units/unit_registry.h>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace mp_units;
+
+namespace {
+
+constexpr long size = 1 << 20;
+
+}  // namespace
+
+int main()
+{
+  const auto& registry = default_unit_registry;
+
+  // the startup cost that `unit_registry` does not have
+  std::unordered_map<std::string, registered_unit> map;
+  benchmark::run("std::unordered_map construction", static_cast<long>(registry.size()), [&] {
+    map.clear();
+    for (const registered_unit& unit : registry) map.emplace(unit.symbol, unit);
+    return map.size();
+  });
+
+  // all the registered symbols and the ones that are not registered
+  std::vector<std::string> symbols = {"xyz", "kmh", "Ki", "mile", "°"};
+  for (const char* symbol : {"m", "km", "ft", "mi", "°C", "°F", "kW", "GiB", "MeV", "pc", "s", "h", "min", "kg",
+                             "lb", "gal", "Pa", "psi", "J", "eV", "W", "hp(I)", "B", "kbit", "au", "ly", "Å"})
+    symbols.emplace_back(symbol);
+  std::mt19937_64 gen(1);
+  std::uniform_int_distribution<std::size_t> pick(0, symbols.size() - 1);
+  std::vector<std::string> inputs;
+  for (long i = 0; i < size; ++i) inputs.push_back(symbols[pick(gen)]);
+
+  benchmark::run("std::unordered_map::find", size, [&] {
+    long double total = 0;
+    for (const auto& input : inputs)
+      if (const auto it = map.find(input); it != map.end()) total += it->second.unit.magnitude;
+    return total;
+  });
+  benchmark::run("unit_registry::find", size, [&] {
+    long double total = 0;
+    for (const auto& input : inputs)
+      if (const registered_unit* unit = registry.find(input)) total += unit->unit.magnitude;
+    return total;
+  });
+  benchmark::run("unit_registry::from_chars", size, [&] {
+    long double total = 0;
+    for (const auto& input : inputs) {
+      registered_unit unit;
+      if (registry.from_chars(input.data(), input.data() + input.size(), unit).ec == std::errc{})
+        total += unit.unit.magnitude;
+    }
+    return total;
+  });
+}
@@ -0,0 +1,106 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Conversions of a range of quantities (`ft` to `m`) performed element by element, with the range `value_cast`
+// writing to a generic output iterator, and with the range `value_cast` of a `quantity_span` (which dispatches at
+// runtime to the widest SIMD kernel supported by the CPU). Every kernel is measured on its own as well.
+
+#include "runtime_benchmark.h"
+#include <mp-units/quantity_span.h>
+#include <mp-units/systems/international/international.h>
+#include <mp-units/systems/si/si.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace mp_units;
+
+namespace {
+
+constexpr long size = 1 << 20;
+
+template<typename Rep>
+void run_all(const std::string& name)
+{
+  std::mt19937_64 gen(1);
+  std::uniform_real_distribution<Rep> dist(-1000, 1000);
+  std::vector<Rep> feet(size), metres(size);
+  std::ranges::generate(feet, [&] { return dist(gen); });
+  const auto in = make_quantity_span<international::foot>(std::as_const(feet));
+  const auto out = make_quantity_span<si::metre>(metres);
+
+  std::vector<quantity<international::foot, Rep>> feet_q;
+  for (Rep v : feet) feet_q.push_back(v * international::foot);
+  std::vector<quantity<si::metre, Rep>> metres_q(size);
+
+  benchmark::run(name + " element-wise", size, [&] {
+    std::ranges::transform(feet_q, metres_q.begin(), [](const auto& q) { return value_cast<si::metre>(q); });
+    return metres_q.back();
+  });
+  benchmark::run(name + " range to std::vector iterator", size, [&] {
+    value_cast<si::metre>(in, metres_q.begin());
+    return metres_q.back();
+  });
+  benchmark::run(name + " range to quantity_span", size, [&] {
+    value_cast<si::metre>(in, out.begin());
+    return metres.back();
+  });
+
+  // the kernels used by the range `value_cast` of a `quantity_span`
+  namespace simd = detail::simd;
+  constexpr Rep factor =
+    detail::fused_conversion_factor<detail::get_canonical_unit(international::foot).mag /
+                                      detail::get_canonical_unit(si::metre).mag,
+                                    Rep>;
+  benchmark::run(name + " scalar kernel", size, [&] {
+    simd::multiply_scalar(feet.data(), feet.size(), factor, metres.data());
+    return metres.back();
+  });
+#if MP_UNITS_SIMD
+  const simd::isa isa = simd::detected_isa();
+  if (isa >= simd::isa::sse2)
+    benchmark::run(name + " sse2 kernel", size, [&] {
+      simd::multiply_sse2(feet.data(), feet.size(), factor, metres.data());
+      return metres.back();
+    });
+  if (isa >= simd::isa::avx2)
+    benchmark::run(name + " avx2 kernel", size, [&] {
+      simd::multiply_avx2(feet.data(), feet.size(), factor, metres.data());
+      return metres.back();
+    });
+  if (isa >= simd::isa::avx512)
+    benchmark::run(name + " avx512 kernel", size, [&] {
+      simd::multiply_avx512(feet.data(), feet.size(), factor, metres.data());
+      return metres.back();
+    });
+#endif
+}
+
+}  // namespace
+
+int main()
+{
+  run_all<double>("double");
+  run_all<float>("float");
+}
@@ -0,0 +1,99 @@
+# The MIT License (MIT)
+#
+# Copyright (c) 2018 Mateusz Pusz
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+cmake_minimum_required(VERSION 3.19)
+
+set(_compile_time_benchmark_dir "${CMAKE_CURRENT_LIST_DIR}")
+
+#
+# add_compile_time_benchmark(Name
+#                            SOURCE <source_file>
+#                            DEPENDENCIES <dependency>...)
+#
+# Compiles the source as a part of the `compile-time-benchmarks` target and records the wall time,
+# peak RSS (if GNU time is available), and the compiler's own statistics (`-ftime-report` for gcc,
+# `-ftime-trace` for clang) into `<Name>.json` in the current binary directory.
+#
+function(add_compile_time_benchmark name)
+    # parse arguments
+    set(oneValues SOURCE)
+    set(multiValues DEPENDENCIES)
+    cmake_parse_arguments(PARSE_ARGV 1 ARG "" "${oneValues}" "${multiValues}")
+
+    # validate and process arguments
+    validate_unparsed(${name} ARG)
+    validate_arguments_exists(${name} ARG SOURCE DEPENDENCIES)
+
+    if(NOT CMAKE_GENERATOR MATCHES "Makefiles|Ninja")
+        message(FATAL_ERROR "Compile-time benchmarks require a Makefile or Ninja generator")
+    endif()
+
+    if(NOT TARGET compile-time-benchmarks)
+        if(CMAKE_HOST_SYSTEM_NAME STREQUAL "Linux")
+            find_program(${projectPrefix}GNU_TIME NAMES time PATHS /usr/bin NO_DEFAULT_PATH)
+        endif()
+
+        # touch all the sources so every run measures a full compilation
+        add_custom_target(compile-time-benchmarks-touch)
+        add_custom_target(
+            compile-time-benchmarks
+            COMMAND
+                ${CMAKE_COMMAND} -DREPORT=${CMAKE_BINARY_DIR}/compile_time_report.json
+                "-DCOMPILER=${CMAKE_CXX_COMPILER_ID} ${CMAKE_CXX_COMPILER_VERSION}"
+                "-DFRAGMENTS=$<TARGET_PROPERTY:compile-time-benchmarks,FRAGMENTS>"
+                -DBASELINE=${${projectPrefix}COMPILE_TIME_BASELINE}
+                -DTHRESHOLD=${${projectPrefix}COMPILE_TIME_THRESHOLD} -P
+                ${_compile_time_benchmark_dir}/CompileTimeBenchmarkReport.cmake
+            COMMENT "Generating the compile-time benchmarks report"
+            VERBATIM
+        )
+    endif()
+
+    set(target mp-units-compile-time-${name})
+    set(fragment ${CMAKE_CURRENT_BINARY_DIR}/${name}.json)
+    add_library(${target} OBJECT EXCLUDE_FROM_ALL ${ARG_SOURCE})
+    target_link_libraries(${target} PRIVATE ${ARG_DEPENDENCIES})
+    target_compile_options(
+        ${target} PRIVATE $<$<CXX_COMPILER_ID:GNU>:-ftime-report> $<$<CXX_COMPILER_ID:Clang,AppleClang>:-ftime-trace>
+    )
+    set_target_properties(
+        ${target}
+        PROPERTIES
+            RULE_LAUNCH_COMPILE
+            "${CMAKE_COMMAND} -DNAME=${name} -DREPORT=${fragment} -DGNU_TIME=${${projectPrefix}GNU_TIME} -P ${_compile_time_benchmark_dir}/CompileTimeBenchmarkRun.cmake --"
+    )
+
+    get_filename_component(source ${ARG_SOURCE} ABSOLUTE)
+    add_custom_command(
+        TARGET compile-time-benchmarks-touch POST_BUILD COMMAND ${CMAKE_COMMAND} -E touch ${source} VERBATIM
+    )
+    add_dependencies(${target} compile-time-benchmarks-touch)
+    add_dependencies(compile-time-benchmarks ${target})
+
+    # build the benchmarks one by one so they do not compete for the CPU
+    get_property(previous GLOBAL PROPERTY ${projectPrefix}LAST_COMPILE_TIME_BENCHMARK)
+    if(previous)
+        add_dependencies(${target} ${previous})
+    endif()
+    set_property(GLOBAL PROPERTY ${projectPrefix}LAST_COMPILE_TIME_BENCHMARK ${target})
+    set_property(TARGET compile-time-benchmarks APPEND PROPERTY FRAGMENTS ${fragment})
+endfunction()
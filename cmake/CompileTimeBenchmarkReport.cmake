@@ -0,0 +1,80 @@
+# The MIT License (MIT)
+#
+# Copyright (c) 2018 Mateusz Pusz
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Merges the results of all the compile-time benchmarks into a single report and optionally compares
+# the wall times with a previous report
+#
+# cmake -DREPORT=<json_file> -DCOMPILER=<id> -DFRAGMENTS=<json_file>... [-DBASELINE=<json_file> [-DTHRESHOLD=<percent>]]
+#       -P CompileTimeBenchmarkReport.cmake
+
+cmake_minimum_required(VERSION 3.19)
+
+set(report "{}")
+string(JSON report SET "${report}" compiler "\"${COMPILER}\"")
+string(JSON report SET "${report}" benchmarks "[]")
+set(idx 0)
+foreach(fragment ${FRAGMENTS})
+    if(NOT EXISTS ${fragment})
+        message(FATAL_ERROR "Missing compile-time benchmark result: ${fragment}")
+    endif()
+    file(READ ${fragment} content)
+    string(JSON report SET "${report}" benchmarks ${idx} "${content}")
+    math(EXPR idx "${idx} + 1")
+endforeach()
+file(WRITE ${REPORT} "${report}\n")
+message(STATUS "Compile-time benchmarks report: ${REPORT}")
+
+if(NOT BASELINE)
+    return()
+endif()
+
+# compare with the baseline
+if(NOT THRESHOLD)
+    set(THRESHOLD 10)
+endif()
+file(READ ${BASELINE} baseline)
+string(JSON baseline_count LENGTH "${baseline}" benchmarks)
+set(regressions)
+math(EXPR last "${idx} - 1")
+foreach(i RANGE ${last})
+    string(JSON name GET "${report}" benchmarks ${i} name)
+    string(JSON wall GET "${report}" benchmarks ${i} wall_time_ms)
+    if(baseline_count EQUAL 0)
+        break()
+    endif()
+    math(EXPR baseline_last "${baseline_count} - 1")
+    foreach(j RANGE ${baseline_last})
+        string(JSON baseline_name GET "${baseline}" benchmarks ${j} name)
+        if(baseline_name STREQUAL name)
+            string(JSON baseline_wall GET "${baseline}" benchmarks ${j} wall_time_ms)
+            math(EXPR limit "${baseline_wall} * (100 + ${THRESHOLD}) / 100")
+            message(STATUS "  ${name}: ${wall} ms (baseline: ${baseline_wall} ms)")
+            if(wall GREATER limit)
+                list(APPEND regressions "${name}")
+            endif()
+        endif()
+    endforeach()
+endforeach()
+
+if(regressions)
+    message(FATAL_ERROR "Compile-time regressions above ${THRESHOLD}% detected in: ${regressions}")
+endif()
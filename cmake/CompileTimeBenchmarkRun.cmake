@@ -0,0 +1,108 @@
+# The MIT License (MIT)
+#
+# Copyright (c) 2018 Mateusz Pusz
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# A compiler launcher measuring the cost of compiling a single translation unit
+#
+# cmake -DNAME=<name> -DREPORT=<json_file> [-DGNU_TIME=<path>] -P CompileTimeBenchmarkRun.cmake -- <compile_command>...
+
+cmake_minimum_required(VERSION 3.19)
+
+# the compile command follows `--`
+set(command)
+set(first -1)
+math(EXPR last "${CMAKE_ARGC} - 1")
+foreach(i RANGE ${last})
+    if(first GREATER_EQUAL 0)
+        list(APPEND command "${CMAKE_ARGV${i}}")
+    elseif(CMAKE_ARGV${i} STREQUAL "--")
+        set(first ${i})
+    endif()
+endforeach()
+
+# find the object file to locate the clang time trace
+list(FIND command "-o" output_idx)
+if(output_idx GREATER_EQUAL 0)
+    math(EXPR output_idx "${output_idx} + 1")
+    list(GET command ${output_idx} object)
+endif()
+
+set(rss_file "${REPORT}.rss")
+if(GNU_TIME)
+    set(command ${GNU_TIME} -f "%M" -o ${rss_file} ${command})
+endif()
+
+if(CMAKE_VERSION VERSION_GREATER_EQUAL 3.23)
+    string(TIMESTAMP start "%s%f" UTC)
+else()
+    string(TIMESTAMP start "%s000000" UTC)
+endif()
+execute_process(COMMAND ${command} RESULT_VARIABLE result OUTPUT_VARIABLE output ERROR_VARIABLE error)
+if(CMAKE_VERSION VERSION_GREATER_EQUAL 3.23)
+    string(TIMESTAMP stop "%s%f" UTC)
+else()
+    string(TIMESTAMP stop "%s000000" UTC)
+endif()
+
+if(NOT result EQUAL 0)
+    message("${output}")
+    message("${error}")
+    message(FATAL_ERROR "Compilation of the '${NAME}' benchmark failed")
+endif()
+
+math(EXPR wall_us "${stop} - ${start}")
+math(EXPR wall_ms "${wall_us} / 1000")
+set(report "{}")
+string(JSON report SET "${report}" name "\"${NAME}\"")
+string(JSON report SET "${report}" wall_time_ms ${wall_ms})
+
+# peak resident set size (GNU time reports kilobytes)
+if(GNU_TIME AND EXISTS ${rss_file})
+    file(STRINGS ${rss_file} rss REGEX "^[0-9]+$")
+    string(JSON report SET "${report}" peak_rss_kb ${rss})
+    file(REMOVE ${rss_file})
+else()
+    string(JSON report SET "${report}" peak_rss_kb null)
+endif()
+
+# gcc `-ftime-report`
+if(error MATCHES "template instantiation[ ]*:[ ]*[0-9.]+[ ]*\\([ 0-9]+%\\)[ ]*[0-9.]+[ ]*\\([ 0-9]+%\\)[ ]*([0-9.]+)")
+    string(JSON report SET "${report}" template_instantiation_s ${CMAKE_MATCH_1})
+endif()
+if(error MATCHES "phase parsing[ ]*:[ ]*[0-9.]+[ ]*\\([ 0-9]+%\\)[ ]*[0-9.]+[ ]*\\([ 0-9]+%\\)[ ]*([0-9.]+)")
+    string(JSON report SET "${report}" parsing_s ${CMAKE_MATCH_1})
+endif()
+
+# clang `-ftime-trace`
+if(object)
+    string(REGEX REPLACE "\\.[^.]*$" ".json" trace ${object})
+    if(EXISTS ${trace})
+        file(READ ${trace} trace_content)
+        foreach(event InstantiateClass InstantiateFunction)
+            if(trace_content MATCHES "\"name\":\"Total ${event}\",\"args\":{\"count\":([0-9]+)")
+                string(JSON report SET "${report}" "${event}_count" ${CMAKE_MATCH_1})
+            endif()
+        endforeach()
+        string(JSON report SET "${report}" trace "\"${trace}\"")
+    endif()
+endif()
+
+file(WRITE ${REPORT} "${report}\n")
@@ -0,0 +1,57 @@
+# The MIT License (MIT)
+#
+# Copyright (c) 2018 Mateusz Pusz
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+
+cmake_minimum_required(VERSION 3.19)
+
+#
+# add_runtime_benchmark(Name
+#                       SOURCE <source_file>
+#                       DEPENDENCIES <dependency>...)
+#
+# Builds the source into an executable run by the `runtime-benchmarks` target. The executable prints
+# the best time out of a few repetitions of every measured kernel.
+#
+function(add_runtime_benchmark name)
+    # parse arguments
+    set(oneValues SOURCE)
+    set(multiValues DEPENDENCIES)
+    cmake_parse_arguments(PARSE_ARGV 1 ARG "" "${oneValues}" "${multiValues}")
+
+    # validate and process arguments
+    validate_unparsed(${name} ARG)
+    validate_arguments_exists(${name} ARG SOURCE DEPENDENCIES)
+
+    if(NOT TARGET runtime-benchmarks)
+        add_custom_target(runtime-benchmarks)
+    endif()
+
+    set(target mp-units-runtime-${name})
+    add_executable(${target} EXCLUDE_FROM_ALL ${ARG_SOURCE})
+    target_link_libraries(${target} PRIVATE ${ARG_DEPENDENCIES})
+
+    add_custom_command(
+        TARGET runtime-benchmarks POST_BUILD COMMAND $<TARGET_FILE:${target}> COMMENT "Running ${name} benchmark"
+        VERBATIM
+    )
+    add_dependencies(runtime-benchmarks ${target})
+endfunction()
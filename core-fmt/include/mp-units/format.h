@@ -27,7 +27,15 @@
 #include <mp-units/customization_points.h>
 #include <mp-units/quantity.h>
 #include <mp-units/unit.h>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 
 // Grammar
 //
@@ -70,13 +78,186 @@ struct quantity_rep_format_specs {
 // Holds specs about the unit (%[specs]q)
 struct quantity_unit_format_specs : unit_symbol_formatting {};
 
+// Precompiled plan for formatting the representation directly with `std::to_chars`
+struct quantity_rep_format_plan {
+  bool to_chars = false;  // `false` if the generic (runtime format string based) path has to be used
+  bool upper = false;
+  int base = 10;
+  std::chars_format format = std::chars_format::general;
+};
+
 template<typename CharT>
 struct quantity_format_specs {
   quantity_global_format_specs<CharT> global;
   quantity_rep_format_specs rep;
   quantity_unit_format_specs unit;
+  quantity_rep_format_plan plan;
 };
 
+template<typename Rep>
+inline constexpr bool is_to_chars_rep =
+  std::is_arithmetic_v<Rep> && !std::is_same_v<Rep, bool> && !std::is_same_v<Rep, char> &&
+  !std::is_same_v<Rep, wchar_t> && !std::is_same_v<Rep, char8_t> && !std::is_same_v<Rep, char16_t> &&
+  !std::is_same_v<Rep, char32_t>;
+
+// Resolves the representation specs to a `std::to_chars` call at parse time
+//  (locale-specific and alternate forms are left to the generic path)
+template<typename Rep>
+[[nodiscard]] constexpr quantity_rep_format_plan make_rep_format_plan(const quantity_rep_format_specs& specs)
+{
+  quantity_rep_format_plan plan;
+  if constexpr (is_to_chars_rep<Rep>) {
+    if (specs.alt || specs.localized) return plan;
+    const char type = specs.type;
+    plan.upper = type == 'E' || type == 'F' || type == 'G' || type == 'X' || type == 'B';
+    if constexpr (treat_as_floating_point<Rep>) {
+      switch (type) {
+        case '\0':
+        case 'g':
+        case 'G':
+          plan.format = std::chars_format::general;
+          break;
+        case 'e':
+        case 'E':
+          plan.format = std::chars_format::scientific;
+          break;
+        case 'f':
+        case 'F':
+          plan.format = std::chars_format::fixed;
+          break;
+        default:
+          return plan;
+      }
+    } else {
+      switch (type) {
+        case '\0':
+        case 'd':
+          plan.base = 10;
+          break;
+        case 'x':
+        case 'X':
+          plan.base = 16;
+          break;
+        case 'o':
+          plan.base = 8;
+          break;
+        case 'b':
+        case 'B':
+          plan.base = 2;
+          break;
+        default:
+          return plan;
+      }
+    }
+    plan.to_chars = true;
+  }
+  return plan;
+}
+
+// A fixed-capacity character buffer living on the stack
+//  Writes past the capacity are counted but dropped, so the caller can detect an overflow and fall back.
+template<typename CharT, std::size_t N>
+class stack_format_buffer {
+  CharT data_[N];
+  std::size_t size_ = 0;
+
+public:
+  class iterator {
+    stack_format_buffer* buf_ = nullptr;
+
+  public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    iterator() = default;
+    explicit iterator(stack_format_buffer& buf) : buf_(&buf) {}
+    iterator& operator=(CharT c)
+    {
+      if (buf_->size_ < N) buf_->data_[buf_->size_] = c;
+      ++buf_->size_;
+      return *this;
+    }
+    iterator& operator*() { return *this; }
+    iterator& operator++() { return *this; }
+    iterator operator++(int) { return *this; }
+  };
+
+  [[nodiscard]] iterator out() { return iterator(*this); }
+  [[nodiscard]] bool overflow() const { return size_ > N; }
+  [[nodiscard]] std::basic_string_view<CharT> view() const { return {data_, size_}; }
+};
+
+// Returns the number of code points in the text (the display width for a UTF-8 encoded `char`)
+template<typename CharT>
+[[nodiscard]] constexpr std::size_t text_width(std::basic_string_view<CharT> text)
+{
+  if constexpr (sizeof(CharT) == 1)
+    return static_cast<std::size_t>(
+      std::ranges::count_if(text, [](CharT c) { return (static_cast<unsigned char>(c) & 0xC0) != 0x80; }));
+  else
+    return text.size();
+}
+
+// Writes the text aligned and padded with the fill character according to the global specs
+template<typename CharT, typename OutputIt>
+OutputIt format_padded(OutputIt out, std::basic_string_view<CharT> text, const quantity_global_format_specs<CharT>& specs)
+{
+  const auto width = static_cast<std::size_t>(specs.width);
+  const auto size = text_width(text);
+  const std::size_t padding = width > size ? width - size : 0;
+  std::size_t left = 0;
+  if (specs.align == fmt_align::right)
+    left = padding;
+  else if (specs.align == fmt_align::center)
+    left = padding / 2;
+
+  const auto fill = [&](std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) out = std::copy_n(specs.fill.data(), specs.fill.size(), out);
+  };
+  fill(left);
+  out = std::copy(text.begin(), text.end(), out);
+  fill(padding - left);
+  return out;
+}
+
+// Formats the representation with `std::to_chars` according to the precompiled plan
+//  Returns `false` if the value does not fit the buffer and nothing was written.
+template<typename CharT, typename Rep, typename OutputIt>
+[[nodiscard]] bool format_rep_to_chars(OutputIt& out, const Rep& val, const quantity_rep_format_specs& specs,
+                                       const quantity_rep_format_plan& plan)
+{
+  char buffer[128];
+  char* const first = buffer + 1;  // reserve space for a sign
+  char* const last = buffer + sizeof(buffer);
+  std::to_chars_result res;
+  if constexpr (treat_as_floating_point<Rep>) {
+    // a (possibly dynamic) precision without a type implies the fixed-point notation
+    const auto format = specs.type == '\0' && specs.precision >= 0 ? std::chars_format::fixed : plan.format;
+    res = std::to_chars(first, last, val, format, specs.precision >= 0 ? specs.precision : 6);
+  } else {
+    res = std::to_chars(first, last, val, plan.base);
+  }
+  if (res.ec != std::errc{}) return false;
+
+  char* begin = first;
+  if (*first != '-') {
+    bool non_negative = true;
+    if constexpr (std::is_floating_point_v<Rep>) non_negative = !std::signbit(val);
+    if (non_negative && specs.sign == fmt_sign::plus)
+      *--begin = '+';
+    else if (non_negative && specs.sign == fmt_sign::space)
+      *--begin = ' ';
+  }
+  if (plan.upper)
+    for (char* it = begin; it != res.ptr; ++it)
+      if (*it >= 'a' && *it <= 'z') *it = static_cast<char>(*it - 'a' + 'A');
+  out = std::copy(begin, res.ptr, out);
+  return true;
+}
+
 // Parse a `units-rep-modifier`
 template<std::input_iterator It, std::sentinel_for<It> S, typename Handler>
 constexpr It parse_units_rep(It begin, S end, Handler&& handler, bool treat_as_floating_point)
@@ -147,8 +328,12 @@ constexpr It parse_units_format(It begin, S end, Handler&& handler)
 // build the 'representation' as requested in the format string, applying only units-rep-modifiers
 template<typename CharT, typename Rep, typename OutputIt, typename Locale>
 [[nodiscard]] OutputIt format_units_quantity_value(OutputIt out, const Rep& val,
-                                                   const quantity_rep_format_specs& rep_specs, const Locale& loc)
+                                                   const quantity_rep_format_specs& rep_specs,
+                                                   const quantity_rep_format_plan& plan, const Locale& loc)
 {
+  if constexpr (is_to_chars_rep<Rep>)
+    if (plan.to_chars && format_rep_to_chars<CharT>(out, val, rep_specs, plan)) return out;
+
   std::basic_string<CharT> buffer;
   auto to_buffer = std::back_inserter(buffer);
 
@@ -217,6 +402,45 @@ OutputIt format_global_buffer(OutputIt out, const quantity_global_format_specs<C
   return MP_UNITS_STD_FMT::format_to(out, "}}");
 }
 
+// Copies the unit symbol generated at compile-time (only `char` symbols are supported for now)
+template<typename CharT, Unit auto U, unit_symbol_formatting Fmt, typename OutputIt>
+OutputIt copy_unit_symbol(OutputIt out)
+{
+  if constexpr (is_same_v<CharT, char>) {
+    constexpr auto& symbol = unit_symbol_v<U, Fmt, CharT>;
+    return std::copy(symbol.begin(), symbol.end(), out);
+  } else
+    return unit_symbol_to<CharT>(out, U, Fmt);
+}
+
+// Dispatches the formatting options selected at runtime to the matching compile-time generated unit symbol
+template<typename CharT, Unit auto U, typename OutputIt>
+OutputIt format_unit_symbol(OutputIt out, unit_symbol_formatting fmt)
+{
+  if constexpr (is_same_v<CharT, char>) {
+    using enum text_encoding;
+    using enum unit_symbol_solidus;
+    using enum unit_symbol_separator;
+    const auto copy_with_solidus = [&]<text_encoding E, unit_symbol_separator S>() {
+      switch (fmt.solidus) {
+        case one_denominator:
+          return copy_unit_symbol<CharT, U, unit_symbol_formatting{E, one_denominator, S}>(out);
+        case always:
+          return copy_unit_symbol<CharT, U, unit_symbol_formatting{E, always, S}>(out);
+        case never:
+          return copy_unit_symbol<CharT, U, unit_symbol_formatting{E, never, S}>(out);
+      }
+      return unit_symbol_to<CharT>(out, U, fmt);
+    };
+    if (fmt.encoding == unicode && fmt.separator == space)
+      return copy_with_solidus.template operator()<unicode, space>();
+    if (fmt.encoding == unicode && fmt.separator == half_high_dot)
+      return copy_with_solidus.template operator()<unicode, half_high_dot>();
+    if (fmt.encoding == ascii && fmt.separator == space) return copy_with_solidus.template operator()<ascii, space>();
+  }
+  return unit_symbol_to<CharT>(out, U, fmt);
+}
+
 template<auto Reference, typename Rep, typename Locale, typename CharT, typename OutputIt>
 struct quantity_formatter {
   OutputIt out;
@@ -239,13 +463,13 @@ struct quantity_formatter {
   template<std::input_iterator It, std::sentinel_for<It> S>
   void on_quantity_value([[maybe_unused]] It, [[maybe_unused]] S)
   {
-    out = format_units_quantity_value<CharT>(out, val, specs.rep, loc);
+    out = format_units_quantity_value<CharT>(out, val, specs.rep, specs.plan, loc);
   }
 
   template<std::input_iterator It, std::sentinel_for<It> S>
   void on_quantity_unit(It, S)
   {
-    out = unit_symbol_to<CharT>(out, get_unit(Reference), specs.unit);
+    out = format_unit_symbol<CharT, get_unit(Reference)>(out, specs.unit);
   }
 };
 
@@ -396,10 +620,12 @@ private:
 
     if (begin == end || *begin == '}') {
       // default format should print value followed by the unit separated with 1 space
-      out = mp_units::detail::format_units_quantity_value<CharT>(out, q.numerical_value(), specs.rep, ctx.locale());
+      out = mp_units::detail::format_units_quantity_value<CharT>(out, q.numerical_value(), specs.rep, specs.plan,
+                                                                 ctx.locale());
       if constexpr (mp_units::detail::has_unit_symbol(get_unit(Reference))) {
         if constexpr (mp_units::space_before_unit_symbol<get_unit(Reference)>) *out++ = CharT(' ');
-        out = unit_symbol_to<CharT>(out, get_unit(Reference));
+        out =
+          mp_units::detail::copy_unit_symbol<CharT, get_unit(Reference), mp_units::unit_symbol_formatting{}>(out);
       }
     } else {
       // user provided format
@@ -413,6 +639,7 @@ public:
   [[nodiscard]] constexpr auto parse(MP_UNITS_STD_FMT::basic_format_parse_context<CharT>& ctx)
   {
     auto range = do_parse(ctx);
+    specs.plan = mp_units::detail::make_rep_format_plan<Rep>(specs.rep);
     if (range.first != range.second)
       format_str = std::basic_string_view<CharT>(&*range.first, static_cast<size_t>(range.second - range.first));
     return range.second;
@@ -432,6 +659,13 @@ public:
     if (specs.global.width == 0) {
       // Avoid extra copying if width is not specified
       return format_quantity_content(ctx.out(), q, ctx);
+    }
+
+    // Format the quantity content on the stack and pad it directly into the output
+    mp_units::detail::stack_format_buffer<CharT, 256> stack_buffer;
+    format_quantity_content(stack_buffer.out(), q, ctx);
+    if (!stack_buffer.overflow()) {
+      return mp_units::detail::format_padded<CharT>(ctx.out(), stack_buffer.view(), specs.global);
     } else {
       // In `quantity_buffer` we will have the representation and the unit formatted according to their
       //  specification, ignoring global specifiers
@@ -25,7 +25,12 @@
 
 #include <mp-units/quantity.h>
 #include <mp-units/unit.h>
+#include <ios>
+#include <iterator>
+#include <locale>
 #include <sstream>
+#include <streambuf>
+#include <type_traits>
 
 namespace mp_units {
 
@@ -41,10 +46,108 @@ void to_stream(std::basic_ostream<CharT, Traits>& os, const quantity<R, Rep>& q)
     os << q.numerical_value();
   if constexpr (has_unit_symbol(get_unit(R))) {
     if constexpr (space_before_unit_symbol<get_unit(R)>) os << " ";
-    unit_symbol_to<CharT>(std::ostream_iterator<CharT>(os), get_unit(R));
+    if constexpr (is_same_v<CharT, char>) {
+      // copy the symbol generated at compile-time
+      constexpr auto& symbol = unit_symbol_v<get_unit(R)>;
+      os.write(symbol.data(), static_cast<std::streamsize>(symbol.size()));
+    } else
+      unit_symbol_to<CharT>(std::ostream_iterator<CharT>(os), get_unit(R));
   }
 }
 
+// A stream buffer writing to a fixed-size array on the stack
+template<typename CharT, typename Traits, std::size_t N>
+class stack_streambuf : public std::basic_streambuf<CharT, Traits> {
+  CharT data_[N];
+
+public:
+  stack_streambuf() { this->setp(data_, data_ + N); }
+  [[nodiscard]] const CharT* data() const { return data_; }
+  [[nodiscard]] std::streamsize size() const { return this->pptr() - this->pbase(); }
+};
+
+template<typename T>
+inline constexpr bool is_num_put_rep =
+  std::is_arithmetic_v<T> && !is_same_v<T, char> && !is_same_v<T, wchar_t> && !is_same_v<T, char8_t> &&
+  !is_same_v<T, char16_t> && !is_same_v<T, char32_t>;
+
+// Converts the value to the type that `std::basic_ostream::operator<<` passes to `std::num_put`
+template<typename T>
+[[nodiscard]] auto to_num_put_arg(const std::ios_base& os, T v)
+{
+  if constexpr (is_same_v<T, bool> || is_same_v<T, long> || is_same_v<T, unsigned long> || is_same_v<T, long long> ||
+                is_same_v<T, unsigned long long> || is_same_v<T, double> || is_same_v<T, long double>)
+    return v;
+  else if constexpr (std::is_floating_point_v<T>)
+    return static_cast<double>(v);
+  else if constexpr (std::is_signed_v<T>) {
+    // `short` and `int` are printed as unsigned values in octal and hexadecimal bases
+    const auto basefield = os.flags() & std::ios_base::basefield;
+    if (basefield == std::ios_base::oct || basefield == std::ios_base::hex)
+      return static_cast<long>(static_cast<std::make_unsigned_t<T>>(v));
+    return static_cast<long>(v);
+  } else
+    return static_cast<unsigned long>(v);
+}
+
+// Prints the quantity padded to the stream width without any intermediate string
+//  Returns `false` if the value does not fit the stack buffer and nothing was written.
+template<typename CharT, class Traits, auto R, typename Rep>
+[[nodiscard]] bool to_stream_padded(std::basic_ostream<CharT, Traits>& os, const quantity<R, Rep>& q)
+{
+  constexpr bool has_symbol = has_unit_symbol(get_unit(R));
+  // no compile-time generated symbols for other character types
+  if constexpr (has_symbol && !is_same_v<CharT, char>) return false;
+
+  const typename std::basic_ostream<CharT, Traits>::sentry cerberus(os);
+  if (!cerberus) return false;
+
+  const std::streamsize width = os.width();
+  os.width(0);
+
+  // render the number with the stream's locale and formatting flags
+  stack_streambuf<CharT, Traits, 128> buf;
+  const auto& facet = std::use_facet<std::num_put<CharT>>(os.getloc());
+  const auto it = facet.put(std::ostreambuf_iterator<CharT, Traits>(&buf), os, os.fill(), [&] {
+    if constexpr (is_same_v<Rep, std::uint8_t> || is_same_v<Rep, std::int8_t>)
+      // promote the value to int
+      return to_num_put_arg(os, +q.numerical_value());
+    else
+      return to_num_put_arg(os, q.numerical_value());
+  }());
+  if (it.failed()) {
+    os.width(width);
+    return false;
+  }
+
+  const CharT space = CharT(' ');
+  std::streamsize space_size = 0;
+  std::basic_string_view<CharT, Traits> symbol;
+  if constexpr (has_symbol) {
+    if constexpr (space_before_unit_symbol<get_unit(R)>) space_size = 1;
+    constexpr auto& s = unit_symbol_v<get_unit(R), unit_symbol_formatting{}, CharT>;
+    symbol = {s.data(), s.size()};
+  }
+
+  // pad on the destination stream (the same rules as for strings apply)
+  const std::streamsize size = buf.size() + space_size + static_cast<std::streamsize>(symbol.size());
+  const std::streamsize padding = width > size ? width - size : 0;
+  const bool left = (os.flags() & std::ios_base::adjustfield) == std::ios_base::left;
+  auto* const sb = os.rdbuf();
+  bool ok = true;
+  const auto pad = [&] {
+    for (std::streamsize i = 0; ok && i < padding; ++i) ok = !Traits::eq_int_type(sb->sputc(os.fill()), Traits::eof());
+  };
+  if (!left) pad();
+  ok = ok && sb->sputn(buf.data(), buf.size()) == buf.size();
+  ok = ok && sb->sputn(&space, space_size) == space_size;
+  ok = ok && sb->sputn(symbol.data(), static_cast<std::streamsize>(symbol.size())) ==
+               static_cast<std::streamsize>(symbol.size());
+  if (left) pad();
+  if (!ok) os.setstate(std::ios_base::badbit);
+  return true;
+}
+
 }  //  namespace detail
 
 template<typename CharT, typename Traits, auto R, typename Rep>
@@ -52,6 +155,9 @@ std::basic_ostream<CharT, Traits>& operator<<(std::basic_ostream<CharT, Traits>&
   requires requires { os << q.numerical_value(); }
 {
   if (os.width()) {
+    if constexpr (detail::is_num_put_rep<Rep>)
+      if (detail::to_stream_padded(os, q)) return os;
+
     // std::setw() applies to the whole quantity output so it has to be first put into std::string
     std::basic_ostringstream<CharT, Traits> oss;
     oss.flags(os.flags());
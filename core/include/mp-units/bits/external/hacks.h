@@ -117,6 +117,30 @@
 
 #endif
 
+#if defined __SIZEOF_INT128__
+
+#define MP_UNITS_HAS_INT128 1
+
+#else
+
+#define MP_UNITS_HAS_INT128 0
+
+#endif
+
+#if defined __has_builtin
+#if __has_builtin(__type_pack_element)
+
+#define MP_UNITS_HAS_TYPE_PACK_ELEMENT 1
+
+#endif
+#endif
+
+#ifndef MP_UNITS_HAS_TYPE_PACK_ELEMENT
+
+#define MP_UNITS_HAS_TYPE_PACK_ELEMENT 0
+
+#endif
+
 #if MP_UNITS_COMP_MSVC
 
 #define MP_UNITS_CONSTRAINED_AUTO_WORKAROUND(X)
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <mp-units/bits/external/hacks.h>  // IWYU pragma: keep
+#include <array>
 #include <cstddef>
 #include <utility>
 
@@ -104,9 +105,30 @@ struct indexed_type_list : detail::indexed_type_list_impl<std::index_sequence_fo
 template<TypeList List, std::size_t I>
 using type_list_element_indexed = typename decltype(detail::type_list_element_func<I>(std::declval<List>()))::type;
 
+#if MP_UNITS_HAS_TYPE_PACK_ELEMENT
+
+namespace detail {
+
+template<typename List, std::size_t I>
+struct type_list_element_impl;
+
+template<template<typename...> typename List, typename... Ts, std::size_t I>
+struct type_list_element_impl<List<Ts...>, I> {
+  using type = __type_pack_element<I, Ts...>;
+};
+
+}  // namespace detail
+
+template<TypeList List, std::size_t I>
+using type_list_element = MP_UNITS_TYPENAME detail::type_list_element_impl<List, I>::type;
+
+#else
+
 template<TypeList List, std::size_t I>
 using type_list_element = type_list_element_indexed<type_list_map<List, indexed_type_list>, I>;
 
+#endif
+
 
 // front
 
@@ -224,6 +246,74 @@ struct type_list_split_half<List<Types...>> : type_list_split<List<Types...>, (s
 
 namespace detail {
 
+#if MP_UNITS_HAS_TYPE_PACK_ELEMENT
+
+// With indexing into packs provided by the compiler the merge is flat: every element of `SortedList2` is binary searched
+// in `SortedList1`, which instantiates only a logarithmic number of predicates, and the result is created with a single
+// pack expansion over the indices of the elements in the merged order.  No partial lists are instantiated and the depth
+// of instantiations is logarithmic.  Without such indexing the element lookups are costlier than the recursive merge.
+
+// The number of leading elements of `Ts` for which `Pred<Element, T>` is `true`.
+template<template<typename, typename> typename Pred, typename T, std::size_t First, std::size_t Count, typename... Ts>
+[[nodiscard]] consteval std::size_t type_list_partition_point()
+{
+  if constexpr (Count == 0)
+    return First;
+  else if constexpr (constexpr std::size_t half = Count / 2; Pred<__type_pack_element<First + half, Ts...>, T>::value)
+    return type_list_partition_point<Pred, T, First + half + 1, Count - half - 1, Ts...>();
+  else
+    return type_list_partition_point<Pred, T, First, half, Ts...>();
+}
+
+// Indices of the elements of the concatenation of both lists in the merged order given the number of elements of the
+// first list that go before each element of the second one.  In case of equivalent elements the ones from the second
+// list go first.
+template<std::size_t N, std::size_t M>
+[[nodiscard]] consteval std::array<std::size_t, N + M> merge_indices(const std::array<std::size_t, M>& lhs_before)
+{
+  std::array<std::size_t, N + M> res{};
+  std::size_t i = 0, j = 0;
+  for (auto& idx : res) idx = (j < M && lhs_before[j] <= i) ? N + j++ : i++;
+  return res;
+}
+
+template<typename List, auto Indices, typename Seq, typename... Ts>
+struct type_list_gather_impl;
+
+template<template<typename...> typename List, auto Indices, std::size_t... Is, typename... Ts>
+struct type_list_gather_impl<List<>, Indices, std::index_sequence<Is...>, Ts...> {
+  using type = List<__type_pack_element<Indices[Is], Ts...>...>;
+};
+
+template<typename SortedList1, typename SortedList2, template<typename, typename> typename Pred>
+struct type_list_merge_sorted_impl;
+
+template<template<typename...> typename List, typename... Lhs, typename... Rhs,
+         template<typename, typename> typename Pred>
+struct type_list_merge_sorted_impl<List<Lhs...>, List<Rhs...>, Pred> {
+  static constexpr auto indices = merge_indices<sizeof...(Lhs)>(std::array<std::size_t, sizeof...(Rhs)>{
+    type_list_partition_point<Pred, Rhs, 0, sizeof...(Lhs), Lhs...>()...});
+  using type = MP_UNITS_TYPENAME type_list_gather_impl<
+    List<>, indices, std::make_index_sequence<sizeof...(Lhs) + sizeof...(Rhs)>, Lhs..., Rhs...>::type;
+};
+
+template<template<typename...> typename List, typename... Lhs, template<typename, typename> typename Pred>
+struct type_list_merge_sorted_impl<List<Lhs...>, List<>, Pred> {
+  using type = List<Lhs...>;
+};
+
+template<template<typename...> typename List, typename... Rhs, template<typename, typename> typename Pred>
+struct type_list_merge_sorted_impl<List<>, List<Rhs...>, Pred> {
+  using type = List<Rhs...>;
+};
+
+template<template<typename...> typename List, template<typename, typename> typename Pred>
+struct type_list_merge_sorted_impl<List<>, List<>, Pred> {
+  using type = List<>;
+};
+
+#else
+
 template<typename SortedList1, typename SortedList2, template<typename, typename> typename Pred>
 struct type_list_merge_sorted_impl;
 
@@ -257,6 +347,8 @@ struct type_list_merge_sorted_impl<List<Lhs1, LhsRest...>, List<Rhs1, RhsRest...
     typename type_list_merge_sorted_impl<List<Lhs1, LhsRest...>, List<RhsRest...>, Pred>::type, Rhs1>::type;
 };
 
+#endif
+
 }  // namespace detail
 
 template<TypeList SortedList1, TypeList SortedList2, template<typename, typename> typename Pred>
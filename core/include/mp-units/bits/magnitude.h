@@ -41,8 +41,9 @@ namespace mp_units {
 
 namespace detail {
 
-// Higher numbers use fewer trial divisions, at the price of more storage space.
-using factorizer = wheel_factorizer<4>;
+// Trial division by the first primes removes the common small factors cheaply; anything left is handled by
+// Miller-Rabin and Pollard's rho.
+using factorizer = pollard_rho_factorizer<25>;
 
 }  // namespace detail
 
@@ -770,10 +771,9 @@ using common_magnitude_type = decltype(common_magnitude_type_impl(M));
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // `mag()` implementation.
 
-// Sometimes we need to give the compiler a "shortcut" when factorizing large numbers (specifically, numbers whose
-// _first factor_ is very large).  If we don't, we can run into limits on the number of constexpr steps or iterations.
-//
-// To provide the first factor for a given number, specialize this variable template.
+// Every number up to `std::intmax_t` is factorized within the default limits on the number of constexpr steps, so
+// specializing this variable template is no longer needed.  It is still honored to give the compiler a "shortcut" for
+// the first factor of a given number, which may save some compile time for huge primes used in many places.
 //
 // WARNING:  The program behaviour will be undefined if you provide a wrong answer, so check your math!
 template<std::intmax_t N>
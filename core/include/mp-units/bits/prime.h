@@ -23,7 +23,10 @@
 #pragma once
 
 #include <mp-units/bits/algorithm.h>
+#include <mp-units/bits/external/hacks.h>
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <numeric>
@@ -153,4 +156,157 @@ struct wheel_factorizer {
   [[nodiscard]] static consteval bool is_prime(std::size_t n) { return (n > 1) && find_first_factor(n) == n; }
 };
 
+// `(a * b) % m` without overflow of the intermediate product.
+[[nodiscard]] constexpr std::uintmax_t mul_mod(std::uintmax_t a, std::uintmax_t b, std::uintmax_t m)
+{
+#if MP_UNITS_HAS_INT128
+  __extension__ using wide_t = unsigned __int128;
+  if constexpr (sizeof(wide_t) >= 2 * sizeof(std::uintmax_t)) {
+    return static_cast<std::uintmax_t>(static_cast<wide_t>(a) * b % m);
+  } else
+#endif
+  {
+    // "double and add" with every intermediate value kept below `m`; it takes up to 64 iterations per product, so the
+    // factorization of the largest 64-bit semiprimes may need a raised constexpr steps limit on such platforms
+    a %= m;
+    b %= m;
+    if (a <= UINT32_MAX && b <= UINT32_MAX) return a * b % m;
+    std::uintmax_t result = 0;
+    while (b > 0) {
+      if (b & 1) result = (result >= m - a) ? result - (m - a) : result + a;
+      a = (a >= m - a) ? a - (m - a) : a + a;
+      b >>= 1;
+    }
+    return result;
+  }
+}
+
+// `(base ^ exp) % m`
+[[nodiscard]] constexpr std::uintmax_t pow_mod(std::uintmax_t base, std::uintmax_t exp, std::uintmax_t m)
+{
+  std::uintmax_t result = 1 % m;
+  base %= m;
+  while (exp > 0) {
+    if (exp & 1) result = mul_mod(result, base, m);
+    base = mul_mod(base, base, m);
+    exp >>= 1;
+  }
+  return result;
+}
+
+// A deterministic Miller-Rabin primality test [1].
+//
+// Testing against the first 12 prime bases gives an exact answer for every `n < 3.3 * 10^24` [2], which covers the
+// whole range of a 64-bit `std::uintmax_t`.  Wider types would need more bases.
+//
+// [1] https://en.wikipedia.org/wiki/Miller%E2%80%93Rabin_primality_test
+// [2] https://oeis.org/A014233
+[[nodiscard]] consteval bool is_prime_miller_rabin(std::uintmax_t n)
+{
+  static_assert(sizeof(std::uintmax_t) <= 8, "Miller-Rabin bases are only known to be sufficient for 64-bit integers");
+
+  constexpr std::uintmax_t bases[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+  if (n < 2) return false;
+  for (auto p : bases) {
+    if (n % p == 0) return n == p;
+  }
+
+  // n - 1 == d * 2^s with odd d
+  std::uintmax_t d = n - 1;
+  int s = 0;
+  while (d % 2 == 0) {
+    d /= 2;
+    ++s;
+  }
+
+  for (auto a : bases) {
+    std::uintmax_t x = pow_mod(a, d, n);
+    if (x == 1 || x == n - 1) continue;
+    bool composite = true;
+    for (int r = 1; r < s && composite; ++r) {
+      x = mul_mod(x, x, n);
+      composite = x != n - 1;
+    }
+    if (composite) return false;
+  }
+  return true;
+}
+
+// Finds a non-trivial divisor of an odd composite `n` with Pollard's rho algorithm in Brent's variant [1].
+//
+// The `gcd` computations are batched over runs of iterations and the polynomial constant `c` is changed whenever a run
+// collapses to `n`, so a divisor is always found for composite inputs.
+//
+// [1] R. P. Brent, "An improved Monte Carlo factorization algorithm", BIT Numerical Mathematics 20 (1980)
+[[nodiscard]] consteval std::uintmax_t pollard_rho(std::uintmax_t n)
+{
+  constexpr std::uintmax_t batch = 128;
+  const auto diff = [](std::uintmax_t a, std::uintmax_t b) { return a > b ? a - b : b - a; };
+
+  for (std::uintmax_t c = 1;; ++c) {
+    const auto f = [&](std::uintmax_t x) { return (mul_mod(x, x, n) + c) % n; };
+    std::uintmax_t y = 2, x = 2, ys = 2, q = 1, g = 1;
+    for (std::uintmax_t r = 1; g == 1; r *= 2) {
+      x = y;
+      for (std::uintmax_t i = 0; i < r; ++i) y = f(y);
+      for (std::uintmax_t k = 0; k < r && g == 1; k += batch) {
+        ys = y;
+        for (std::uintmax_t i = 0; i < batch && i < r - k; ++i) {
+          y = f(y);
+          q = mul_mod(q, diff(x, y), n);
+        }
+        g = std::gcd(q, n);
+      }
+    }
+    if (g == n) {
+      // the batch overshot; step through it one iteration at a time
+      do {
+        ys = f(ys);
+        g = std::gcd(diff(x, ys), n);
+      } while (g == 1);
+    }
+    if (g != n) return g;
+  }
+}
+
+// The largest integer `r` with `r * r <= n`.
+[[nodiscard]] consteval std::uintmax_t isqrt(std::uintmax_t n)
+{
+  if (n < 2) return n;
+  // Newton's iteration starting from a power of two that is not smaller than the result
+  std::uintmax_t x = std::uintmax_t{1} << ((std::bit_width(n) + 1) / 2);
+  for (std::uintmax_t y = (x + n / x) / 2; y < x; y = (x + n / x) / 2) x = y;
+  return x;
+}
+
+// A factorizer for the whole range of `std::uintmax_t`.
+//
+// Small factors are removed by trial division with the first `TrialPrimes` primes.  Whatever remains is either proven
+// prime with `is_prime_miller_rabin()` or split with `pollard_rho()`, so the cost no longer depends on the magnitude of
+// the smallest prime factor, and even 64-bit primes and semiprimes factor well within the default constexpr limits.
+template<std::size_t TrialPrimes>
+struct pollard_rho_factorizer {
+  static constexpr auto trial_primes = first_n_primes<TrialPrimes>();
+
+  // Returns the smallest prime factor of `n`.
+  [[nodiscard]] static consteval std::uintmax_t find_first_factor(std::uintmax_t n)
+  {
+    if (const auto k = detail::get_first_of(trial_primes, [&](auto p) { return first_factor_maybe(n, p); })) return *k;
+    return find_first_factor_without_small_primes(n);
+  }
+
+  [[nodiscard]] static consteval bool is_prime(std::uintmax_t n) { return is_prime_miller_rabin(n); }
+
+private:
+  // Precondition: `n` has no factors among `trial_primes`.
+  [[nodiscard]] static consteval std::uintmax_t find_first_factor_without_small_primes(std::uintmax_t n)
+  {
+    if (n == 1 || is_prime_miller_rabin(n)) return n;
+    // Pollard's rho needs about `sqrt(p)` steps for a factor `p`, which makes squares of big primes its worst case
+    if (const std::uintmax_t r = isqrt(n); r * r == n) return find_first_factor_without_small_primes(r);
+    const std::uintmax_t d = pollard_rho(n);
+    return std::min(find_first_factor_without_small_primes(d), find_first_factor_without_small_primes(n / d));
+  }
+};
+
 }  // namespace mp_units::detail
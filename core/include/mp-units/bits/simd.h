@@ -0,0 +1,851 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <mp-units/bits/external/hacks.h>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// Set to `0` to disable the explicit SIMD kernels and rely only on the compiler's auto-vectorization
+#ifndef MP_UNITS_SIMD
+#if (MP_UNITS_COMP_GCC || MP_UNITS_COMP_CLANG) && (defined __x86_64__ || defined __i386__)
+#define MP_UNITS_SIMD 1
+#else
+#define MP_UNITS_SIMD 0
+#endif
+#endif
+
+#if MP_UNITS_SIMD
+#include <immintrin.h>
+#endif
+
+namespace mp_units::detail::simd {
+
+/**
+ * @brief The best instruction set available on the current CPU
+ *
+ * Detected once at runtime. Always `scalar` if the explicit SIMD kernels are disabled.
+ */
+enum class isa { scalar, sse2, avx2, avx512 };
+
+[[nodiscard]] inline isa detected_isa() noexcept
+{
+#if MP_UNITS_SIMD
+  static const isa best = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return isa::avx512;
+    if (__builtin_cpu_supports("avx2")) return isa::avx2;
+    if (__builtin_cpu_supports("sse2")) return isa::sse2;
+    return isa::scalar;
+  }();
+  return best;
+#else
+  return isa::scalar;
+#endif
+}
+
+template<typename T>
+constexpr void multiply_scalar(const T* in, std::size_t n, T factor, T* out)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = in[i] * factor;
+}
+
+#if MP_UNITS_SIMD
+
+// `in` and `out` may be the same buffer, otherwise they should not overlap
+__attribute__((target("sse2"))) inline void multiply_sse2(const double* in, std::size_t n, double factor, double* out)
+{
+  const __m128d f = _mm_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(in + i), f));
+  multiply_scalar(in + i, n - i, factor, out + i);
+}
+
+__attribute__((target("sse2"))) inline void multiply_sse2(const float* in, std::size_t n, float factor, float* out)
+{
+  const __m128 f = _mm_set1_ps(factor);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), f));
+  multiply_scalar(in + i, n - i, factor, out + i);
+}
+
+__attribute__((target("avx2"))) inline void multiply_avx2(const double* in, std::size_t n, double factor, double* out)
+{
+  const __m256d f = _mm256_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256d a = _mm256_loadu_pd(in + i);
+    const __m256d b = _mm256_loadu_pd(in + i + 4);
+    _mm256_storeu_pd(out + i, _mm256_mul_pd(a, f));
+    _mm256_storeu_pd(out + i + 4, _mm256_mul_pd(b, f));
+  }
+  for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(in + i), f));
+  multiply_scalar(in + i, n - i, factor, out + i);
+}
+
+__attribute__((target("avx2"))) inline void multiply_avx2(const float* in, std::size_t n, float factor, float* out)
+{
+  const __m256 f = _mm256_set1_ps(factor);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m256 a = _mm256_loadu_ps(in + i);
+    const __m256 b = _mm256_loadu_ps(in + i + 8);
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(a, f));
+    _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(b, f));
+  }
+  for (; i + 8 <= n; i += 8) _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(in + i), f));
+  multiply_scalar(in + i, n - i, factor, out + i);
+}
+
+__attribute__((target("avx512f"))) inline void multiply_avx512(const double* in, std::size_t n, double factor,
+                                                               double* out)
+{
+  const __m512d f = _mm512_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) _mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_loadu_pd(in + i), f));
+  if (i < n) {
+    const auto mask = static_cast<__mmask8>((1u << (n - i)) - 1);
+    _mm512_mask_storeu_pd(out + i, mask, _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, in + i), f));
+  }
+}
+
+__attribute__((target("avx512f"))) inline void multiply_avx512(const float* in, std::size_t n, float factor,
+                                                               float* out)
+{
+  const __m512 f = _mm512_set1_ps(factor);
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_loadu_ps(in + i), f));
+  if (i < n) {
+    const auto mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+    _mm512_mask_storeu_ps(out + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, in + i), f));
+  }
+}
+
+#endif
+
+/**
+ * @brief Multiplies `n` values from `in` by `factor` and stores the results in `out`
+ *
+ * Dispatches at runtime to the widest kernel supported by the CPU. Each element is rounded exactly as
+ * `in[i] * factor`, so the results do not depend on the selected kernel. `in` and `out` may be the same
+ * buffer, otherwise they should not overlap.
+ */
+template<typename T>
+  requires std::same_as<T, float> || std::same_as<T, double>
+inline void multiply(const T* in, std::size_t n, T factor, T* out)
+{
+#if MP_UNITS_SIMD
+  switch (detected_isa()) {
+    case isa::avx512:
+      return multiply_avx512(in, n, factor, out);
+    case isa::avx2:
+      return multiply_avx2(in, n, factor, out);
+    case isa::sse2:
+      return multiply_sse2(in, n, factor, out);
+    case isa::scalar:
+      break;
+  }
+#endif
+  multiply_scalar(in, n, factor, out);
+}
+
+/**
+ * @brief Neumaier's improved Kahan-Babuska compensated summation
+ *
+ * Keeps the running compensation of the rounding errors of the additions also when the added value is larger than
+ * the running sum. Does not work if the compiler is allowed to reassociate floating-point operations
+ * (i.e. `-ffast-math`).
+ */
+template<typename T>
+struct neumaier_sum {
+  T sum{};
+  T compensation{};
+
+  constexpr void add(T x)
+  {
+    // Knuth's branch-free TwoSum gives the same error term as the comparison of the magnitudes of the operands
+    const T t = sum + x;
+    const T z = t - sum;
+    compensation += (sum - (t - z)) + (x - z);
+    sum = t;
+  }
+
+  constexpr void merge(const neumaier_sum& other)
+  {
+    add(other.sum);
+    compensation += other.compensation;
+  }
+
+  [[nodiscard]] constexpr T result() const { return sum + compensation; }
+};
+
+template<typename T>
+constexpr T sum_scalar(const T* in, std::size_t n)
+{
+  T acc[4]{};
+  // counted in blocks as GCC 12 reports a false positive `-Waggressive-loop-optimizations` for `i + 4 <= n` when
+  // `n` is a constant
+  const std::size_t end = n - n % 4;
+  std::size_t i = 0;
+  for (; i != end; i += 4)
+    for (std::size_t k = 0; k < 4; ++k) acc[k] += in[i + k];
+  for (; i < n; ++i) acc[0] += in[i];
+  return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+template<typename T>
+constexpr neumaier_sum<T> sum_compensated_scalar(const T* in, std::size_t n)
+{
+  neumaier_sum<T> acc;
+  for (std::size_t i = 0; i < n; ++i) acc.add(in[i]);
+  return acc;
+}
+
+#if MP_UNITS_SIMD
+
+template<typename T, std::size_t Lanes>
+[[nodiscard]] T horizontal_sum(const T (&lanes)[Lanes])
+{
+  T sum{};
+  for (T v : lanes) sum += v;
+  return sum;
+}
+
+template<typename T, std::size_t Lanes>
+[[nodiscard]] neumaier_sum<T> merge_lanes(const T (&sum)[Lanes], const T (&compensation)[Lanes])
+{
+  neumaier_sum<T> acc;
+  for (std::size_t k = 0; k < Lanes; ++k) acc.merge({sum[k], compensation[k]});
+  return acc;
+}
+
+__attribute__((target("avx2"))) inline double sum_avx2(const double* in, std::size_t n)
+{
+  __m256d acc[4] = {_mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd()};
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+    for (std::size_t k = 0; k < 4; ++k) acc[k] = _mm256_add_pd(acc[k], _mm256_loadu_pd(in + i + 4 * k));
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, _mm256_add_pd(_mm256_add_pd(acc[0], acc[1]), _mm256_add_pd(acc[2], acc[3])));
+  return horizontal_sum(lanes) + sum_scalar(in + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline float sum_avx2(const float* in, std::size_t n)
+{
+  __m256 acc[4] = {_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps()};
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32)
+    for (std::size_t k = 0; k < 4; ++k) acc[k] = _mm256_add_ps(acc[k], _mm256_loadu_ps(in + i + 8 * k));
+  alignas(32) float lanes[8];
+  _mm256_store_ps(lanes, _mm256_add_ps(_mm256_add_ps(acc[0], acc[1]), _mm256_add_ps(acc[2], acc[3])));
+  return horizontal_sum(lanes) + sum_scalar(in + i, n - i);
+}
+
+// the compensated kernels keep 2 independent vectors of sums and compensations to hide the latency of the additions
+__attribute__((target("avx2"))) inline neumaier_sum<double> sum_compensated_avx2(const double* in, std::size_t n)
+{
+  const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fff'ffff'ffff'ffff));
+  __m256d sum[2] = {_mm256_setzero_pd(), _mm256_setzero_pd()};
+  __m256d comp[2] = {_mm256_setzero_pd(), _mm256_setzero_pd()};
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    for (std::size_t k = 0; k < 2; ++k) {
+      const __m256d x = _mm256_loadu_pd(in + i + 4 * k);
+      const __m256d t = _mm256_add_pd(sum[k], x);
+      const __m256d sum_larger =
+        _mm256_cmp_pd(_mm256_and_pd(sum[k], abs_mask), _mm256_and_pd(x, abs_mask), _CMP_GE_OQ);
+      const __m256d c = _mm256_blendv_pd(_mm256_add_pd(_mm256_sub_pd(x, t), sum[k]),
+                                         _mm256_add_pd(_mm256_sub_pd(sum[k], t), x), sum_larger);
+      comp[k] = _mm256_add_pd(comp[k], c);
+      sum[k] = t;
+    }
+  alignas(32) double s[8], c[8];
+  _mm256_store_pd(s, sum[0]);
+  _mm256_store_pd(s + 4, sum[1]);
+  _mm256_store_pd(c, comp[0]);
+  _mm256_store_pd(c + 4, comp[1]);
+  neumaier_sum<double> acc = merge_lanes(s, c);
+  acc.merge(sum_compensated_scalar(in + i, n - i));
+  return acc;
+}
+
+__attribute__((target("avx2"))) inline neumaier_sum<float> sum_compensated_avx2(const float* in, std::size_t n)
+{
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fff'ffff));
+  __m256 sum[2] = {_mm256_setzero_ps(), _mm256_setzero_ps()};
+  __m256 comp[2] = {_mm256_setzero_ps(), _mm256_setzero_ps()};
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+    for (std::size_t k = 0; k < 2; ++k) {
+      const __m256 x = _mm256_loadu_ps(in + i + 8 * k);
+      const __m256 t = _mm256_add_ps(sum[k], x);
+      const __m256 sum_larger = _mm256_cmp_ps(_mm256_and_ps(sum[k], abs_mask), _mm256_and_ps(x, abs_mask), _CMP_GE_OQ);
+      const __m256 c = _mm256_blendv_ps(_mm256_add_ps(_mm256_sub_ps(x, t), sum[k]),
+                                        _mm256_add_ps(_mm256_sub_ps(sum[k], t), x), sum_larger);
+      comp[k] = _mm256_add_ps(comp[k], c);
+      sum[k] = t;
+    }
+  alignas(32) float s[16], c[16];
+  _mm256_store_ps(s, sum[0]);
+  _mm256_store_ps(s + 8, sum[1]);
+  _mm256_store_ps(c, comp[0]);
+  _mm256_store_ps(c + 8, comp[1]);
+  neumaier_sum<float> acc = merge_lanes(s, c);
+  acc.merge(sum_compensated_scalar(in + i, n - i));
+  return acc;
+}
+
+__attribute__((target("avx512f"))) inline double sum_avx512(const double* in, std::size_t n)
+{
+  __m512d acc[4] = {_mm512_setzero_pd(), _mm512_setzero_pd(), _mm512_setzero_pd(), _mm512_setzero_pd()};
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32)
+    for (std::size_t k = 0; k < 4; ++k) acc[k] = _mm512_add_pd(acc[k], _mm512_loadu_pd(in + i + 8 * k));
+  alignas(64) double lanes[8];
+  _mm512_store_pd(lanes, _mm512_add_pd(_mm512_add_pd(acc[0], acc[1]), _mm512_add_pd(acc[2], acc[3])));
+  return horizontal_sum(lanes) + sum_scalar(in + i, n - i);
+}
+
+__attribute__((target("avx512f"))) inline float sum_avx512(const float* in, std::size_t n)
+{
+  __m512 acc[4] = {_mm512_setzero_ps(), _mm512_setzero_ps(), _mm512_setzero_ps(), _mm512_setzero_ps()};
+  std::size_t i = 0;
+  for (; i + 64 <= n; i += 64)
+    for (std::size_t k = 0; k < 4; ++k) acc[k] = _mm512_add_ps(acc[k], _mm512_loadu_ps(in + i + 16 * k));
+  alignas(64) float lanes[16];
+  _mm512_store_ps(lanes, _mm512_add_ps(_mm512_add_ps(acc[0], acc[1]), _mm512_add_ps(acc[2], acc[3])));
+  return horizontal_sum(lanes) + sum_scalar(in + i, n - i);
+}
+
+__attribute__((target("avx512f"))) inline neumaier_sum<double> sum_compensated_avx512(const double* in,
+                                                                                      std::size_t n)
+{
+  __m512d sum[2] = {_mm512_setzero_pd(), _mm512_setzero_pd()};
+  __m512d comp[2] = {_mm512_setzero_pd(), _mm512_setzero_pd()};
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16)
+    for (std::size_t k = 0; k < 2; ++k) {
+      const __m512d x = _mm512_loadu_pd(in + i + 8 * k);
+      const __m512d t = _mm512_add_pd(sum[k], x);
+      const __mmask8 sum_larger = _mm512_cmp_pd_mask(_mm512_abs_pd(sum[k]), _mm512_abs_pd(x), _CMP_GE_OQ);
+      const __m512d c = _mm512_mask_blend_pd(sum_larger, _mm512_add_pd(_mm512_sub_pd(x, t), sum[k]),
+                                             _mm512_add_pd(_mm512_sub_pd(sum[k], t), x));
+      comp[k] = _mm512_add_pd(comp[k], c);
+      sum[k] = t;
+    }
+  alignas(64) double s[16], c[16];
+  _mm512_store_pd(s, sum[0]);
+  _mm512_store_pd(s + 8, sum[1]);
+  _mm512_store_pd(c, comp[0]);
+  _mm512_store_pd(c + 8, comp[1]);
+  neumaier_sum<double> acc = merge_lanes(s, c);
+  acc.merge(sum_compensated_scalar(in + i, n - i));
+  return acc;
+}
+
+__attribute__((target("avx512f"))) inline neumaier_sum<float> sum_compensated_avx512(const float* in, std::size_t n)
+{
+  __m512 sum[2] = {_mm512_setzero_ps(), _mm512_setzero_ps()};
+  __m512 comp[2] = {_mm512_setzero_ps(), _mm512_setzero_ps()};
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32)
+    for (std::size_t k = 0; k < 2; ++k) {
+      const __m512 x = _mm512_loadu_ps(in + i + 16 * k);
+      const __m512 t = _mm512_add_ps(sum[k], x);
+      const __mmask16 sum_larger = _mm512_cmp_ps_mask(_mm512_abs_ps(sum[k]), _mm512_abs_ps(x), _CMP_GE_OQ);
+      const __m512 c = _mm512_mask_blend_ps(sum_larger, _mm512_add_ps(_mm512_sub_ps(x, t), sum[k]),
+                                            _mm512_add_ps(_mm512_sub_ps(sum[k], t), x));
+      comp[k] = _mm512_add_ps(comp[k], c);
+      sum[k] = t;
+    }
+  alignas(64) float s[32], c[32];
+  _mm512_store_ps(s, sum[0]);
+  _mm512_store_ps(s + 16, sum[1]);
+  _mm512_store_ps(c, comp[0]);
+  _mm512_store_ps(c + 16, comp[1]);
+  neumaier_sum<float> acc = merge_lanes(s, c);
+  acc.merge(sum_compensated_scalar(in + i, n - i));
+  return acc;
+}
+
+#endif
+
+/**
+ * @brief Sums `n` values from `in` with several independent accumulators
+ *
+ * Dispatches at runtime to the widest kernel supported by the CPU. The order of the additions (and so the rounding
+ * of the result) depends on the selected kernel.
+ */
+template<typename T>
+  requires std::same_as<T, float> || std::same_as<T, double>
+[[nodiscard]] inline T sum(const T* in, std::size_t n)
+{
+#if MP_UNITS_SIMD
+  switch (detected_isa()) {
+    case isa::avx512:
+      return sum_avx512(in, n);
+    case isa::avx2:
+      return sum_avx2(in, n);
+    case isa::sse2:
+    case isa::scalar:
+      break;
+  }
+#endif
+  return sum_scalar(in, n);
+}
+
+/**
+ * @brief Sums `n` values from `in` with Neumaier's compensated summation
+ *
+ * Dispatches at runtime to the widest kernel supported by the CPU. Every lane of the vector kernels keeps its own
+ * compensation and the lanes are merged with a compensated addition as well.
+ */
+template<typename T>
+  requires std::same_as<T, float> || std::same_as<T, double>
+[[nodiscard]] inline neumaier_sum<T> sum_compensated(const T* in, std::size_t n)
+{
+#if MP_UNITS_SIMD
+  switch (detected_isa()) {
+    case isa::avx512:
+      return sum_compensated_avx512(in, n);
+    case isa::avx2:
+      return sum_compensated_avx2(in, n);
+    case isa::sse2:
+    case isa::scalar:
+      break;
+  }
+#endif
+  return sum_compensated_scalar(in, n);
+}
+
+template<typename T>
+concept SimdSaturable = std::same_as<T, std::int8_t> || std::same_as<T, std::uint8_t> ||
+                        std::same_as<T, std::int16_t> || std::same_as<T, std::uint16_t>;
+
+// branch-free (and auto-vectorizable) saturating addition
+template<std::integral T>
+[[nodiscard]] constexpr T add_sat_scalar(T lhs, T rhs)
+{
+  using unsigned_type = std::make_unsigned_t<T>;
+  constexpr int sign_shift = std::numeric_limits<unsigned_type>::digits - 1;
+  const auto a = static_cast<unsigned_type>(lhs);
+  const auto b = static_cast<unsigned_type>(rhs);
+  const auto sum = static_cast<unsigned_type>(a + b);
+  if constexpr (std::is_signed_v<T>) {
+    // the addition overflowed if the sign of the result differs from the signs of both operands
+    const bool overflow = static_cast<unsigned_type>((a ^ sum) & (b ^ sum)) >> sign_shift;
+    // `max` for non-negative operands and `min` (`max + 1`) for negative ones
+    const auto saturated = static_cast<unsigned_type>(static_cast<unsigned_type>(std::numeric_limits<T>::max()) +
+                                                      static_cast<unsigned_type>(a >> sign_shift));
+    return static_cast<T>(overflow ? saturated : sum);
+  } else
+    return sum < a ? std::numeric_limits<T>::max() : static_cast<T>(sum);
+}
+
+template<std::integral T>
+constexpr void add_sat_scalar(const T* lhs, const T* rhs, std::size_t n, T* out)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = add_sat_scalar(lhs[i], rhs[i]);
+}
+
+#if MP_UNITS_SIMD
+
+template<SimdSaturable T>
+__attribute__((target("sse2"))) inline __m128i add_sat_m128(__m128i lhs, __m128i rhs)
+{
+  if constexpr (std::same_as<T, std::int8_t>)
+    return _mm_adds_epi8(lhs, rhs);
+  else if constexpr (std::same_as<T, std::uint8_t>)
+    return _mm_adds_epu8(lhs, rhs);
+  else if constexpr (std::same_as<T, std::int16_t>)
+    return _mm_adds_epi16(lhs, rhs);
+  else
+    return _mm_adds_epu16(lhs, rhs);
+}
+
+template<SimdSaturable T>
+__attribute__((target("avx2"))) inline __m256i add_sat_m256(__m256i lhs, __m256i rhs)
+{
+  if constexpr (std::same_as<T, std::int8_t>)
+    return _mm256_adds_epi8(lhs, rhs);
+  else if constexpr (std::same_as<T, std::uint8_t>)
+    return _mm256_adds_epu8(lhs, rhs);
+  else if constexpr (std::same_as<T, std::int16_t>)
+    return _mm256_adds_epi16(lhs, rhs);
+  else
+    return _mm256_adds_epu16(lhs, rhs);
+}
+
+template<SimdSaturable T>
+__attribute__((target("sse2"))) inline void add_sat_sse2(const T* lhs, const T* rhs, std::size_t n, T* out)
+{
+  constexpr std::size_t lanes = sizeof(__m128i) / sizeof(T);
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), add_sat_m128<T>(a, b));
+  }
+  add_sat_scalar(lhs + i, rhs + i, n - i, out + i);
+}
+
+template<SimdSaturable T>
+__attribute__((target("avx2"))) inline void add_sat_avx2(const T* lhs, const T* rhs, std::size_t n, T* out)
+{
+  constexpr std::size_t lanes = sizeof(__m256i) / sizeof(T);
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), add_sat_m256<T>(a, b));
+  }
+  add_sat_sse2(lhs + i, rhs + i, n - i, out + i);
+}
+
+#endif
+
+/**
+ * @brief Adds `n` pairs of integers from `lhs` and `rhs` saturating the results at the limits of `T`
+ *
+ * 8- and 16-bit integers are added with the saturating SIMD instructions selected at runtime (AVX-512F has no
+ * 8- and 16-bit ones, so AVX2 is used on such CPUs). The other types are added with a branch-free loop that the
+ * compiler may vectorize. `out` may be the same buffer as one of the inputs, otherwise the buffers should not
+ * overlap.
+ */
+template<std::integral T>
+inline void add_sat(const T* lhs, const T* rhs, std::size_t n, T* out)
+{
+#if MP_UNITS_SIMD
+  if constexpr (SimdSaturable<T>) {
+    switch (detected_isa()) {
+      case isa::avx512:
+      case isa::avx2:
+        return add_sat_avx2(lhs, rhs, n, out);
+      case isa::sse2:
+        return add_sat_sse2(lhs, rhs, n, out);
+      case isa::scalar:
+        break;
+    }
+  }
+#endif
+  add_sat_scalar(lhs, rhs, n, out);
+}
+
+/**
+ * @brief Rounds a `float` to the nearest IEEE 754 binary16 value (ties to even)
+ *
+ * Gives the same results as the F16C `vcvtps2ph` instruction: the values too large for binary16 become infinities
+ * and NaNs are quieted keeping the upper bits of their payload.
+ *
+ * @return the bits of the binary16 value
+ */
+[[nodiscard]] constexpr std::uint16_t float_to_binary16(float v)
+{
+  const auto x = std::bit_cast<std::uint32_t>(v);
+  const auto sign = static_cast<std::uint16_t>((x >> 16) & 0x8000u);
+  const std::uint32_t abs = x & 0x7FFF'FFFFu;
+  if (abs > 0x7F80'0000u) return static_cast<std::uint16_t>(sign | 0x7E00u | ((abs >> 13) & 0x3FFu));  // NaN
+  if (abs >= 0x477F'F000u) return static_cast<std::uint16_t>(sign | 0x7C00u);  // rounds to infinity
+  if (abs >= 0x3880'0000u) {
+    // a normal value: rebias the exponent and round the 13 dropped bits of the mantissa
+    return static_cast<std::uint16_t>(sign | ((abs + 0xC800'0FFFu + ((abs >> 13) & 1u)) >> 13));
+  }
+  if (abs < 0x3300'0000u) return sign;  // rounds to zero
+  // a subnormal value
+  const int shift = 126 - static_cast<int>(abs >> 23);
+  const std::uint32_t mantissa = (abs & 0x7F'FFFFu) | 0x80'0000u;
+  std::uint32_t res = mantissa >> shift;
+  const std::uint32_t rem = mantissa & ((1u << shift) - 1);
+  const std::uint32_t half = 1u << (shift - 1);
+  if (rem > half || (rem == half && (res & 1u) != 0)) ++res;
+  return static_cast<std::uint16_t>(sign | res);
+}
+
+/**
+ * @brief Converts the bits of an IEEE 754 binary16 value to `float`
+ *
+ * The conversion is exact with the exception of signaling NaNs that are quieted.
+ */
+[[nodiscard]] constexpr float binary16_to_float(std::uint16_t h)
+{
+  const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+  const std::uint32_t exp = (h >> 10) & 0x1Fu;
+  const std::uint32_t mantissa = h & 0x3FFu;
+  if (exp == 0x1F) {
+    // infinity or a NaN (quieted like `vcvtph2ps` does)
+    const std::uint32_t quiet = mantissa != 0 ? 0x40'0000u : 0u;
+    return std::bit_cast<float>(sign | 0x7F80'0000u | quiet | (mantissa << 13));
+  }
+  if (exp == 0) {
+    // zero or a subnormal value (exactly representable as a normal `float`)
+    const float abs = static_cast<float>(mantissa) * 0x1p-24f;
+    return std::bit_cast<float>(sign | std::bit_cast<std::uint32_t>(abs));
+  }
+  return std::bit_cast<float>(sign | ((exp + 112) << 23) | (mantissa << 13));
+}
+
+/**
+ * @brief Rounds a `float` to the nearest bfloat16 value (ties to even)
+ *
+ * Gives the same results as the AVX-512-BF16 `vcvtneps2bf16` instruction: the subnormal values are flushed to zero
+ * and NaNs are quieted.
+ *
+ * @return the bits of the bfloat16 value
+ */
+[[nodiscard]] constexpr std::uint16_t float_to_bfloat16(float v)
+{
+  std::uint32_t x = std::bit_cast<std::uint32_t>(v);
+  if ((x & 0x7F80'0000u) == 0) x &= 0x8000'0000u;
+  if ((x & 0x7FFF'FFFFu) > 0x7F80'0000u) return static_cast<std::uint16_t>((x >> 16) | 0x40u);
+  return static_cast<std::uint16_t>((x + 0x7FFFu + ((x >> 16) & 1u)) >> 16);
+}
+
+/**
+ * @brief Converts the bits of a bfloat16 value to `float` (always exact)
+ */
+[[nodiscard]] constexpr float bfloat16_to_float(std::uint16_t h)
+{
+  return std::bit_cast<float>(static_cast<std::uint32_t>(h) << 16);
+}
+
+constexpr void narrow_binary16_scalar(const float* in, std::size_t n, std::uint16_t* out)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = float_to_binary16(in[i]);
+}
+
+constexpr void widen_binary16_scalar(const std::uint16_t* in, std::size_t n, float* out)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = binary16_to_float(in[i]);
+}
+
+constexpr void narrow_bfloat16_scalar(const float* in, std::size_t n, std::uint16_t* out)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = float_to_bfloat16(in[i]);
+}
+
+constexpr void widen_bfloat16_scalar(const std::uint16_t* in, std::size_t n, float* out)
+{
+  for (std::size_t i = 0; i < n; ++i) out[i] = bfloat16_to_float(in[i]);
+}
+
+#if MP_UNITS_SIMD
+
+// the conversion instructions that are not a part of the `isa` levels
+[[nodiscard]] inline bool has_f16c() noexcept
+{
+  static const bool res = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+  }();
+  return res;
+}
+
+[[nodiscard]] inline bool has_avx512bf16() noexcept
+{
+  static const bool res = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bf16");
+  }();
+  return res;
+}
+
+__attribute__((target("avx,f16c"))) inline void narrow_binary16_f16c(const float* in, std::size_t n,
+                                                                    std::uint16_t* out)
+{
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+  narrow_binary16_scalar(in + i, n - i, out + i);
+}
+
+__attribute__((target("avx,f16c"))) inline void widen_binary16_f16c(const std::uint16_t* in, std::size_t n,
+                                                                   float* out)
+{
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))));
+  widen_binary16_scalar(in + i, n - i, out + i);
+}
+
+// the zero-masked forms of the AVX-512 conversions do not read an undefined source register (GCC 12 warns about
+// the unmasked ones as possibly uninitialized)
+inline constexpr __mmask16 all_lanes = 0xFFFF;
+
+__attribute__((target("avx512f"))) inline void narrow_binary16_avx512(const float* in, std::size_t n,
+                                                                     std::uint16_t* out)
+{
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m256i res =
+      _mm512_maskz_cvtps_ph(all_lanes, _mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), res);
+  }
+  narrow_binary16_scalar(in + i, n - i, out + i);
+}
+
+__attribute__((target("avx512f"))) inline void widen_binary16_avx512(const std::uint16_t* in, std::size_t n,
+                                                                    float* out)
+{
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    _mm512_storeu_ps(out + i, _mm512_maskz_cvtph_ps(all_lanes, x));
+  }
+  widen_binary16_scalar(in + i, n - i, out + i);
+}
+
+__attribute__((target("avx512f,avx512bf16"))) inline void narrow_bfloat16_avx512bf16(const float* in, std::size_t n,
+                                                                                     std::uint16_t* out)
+{
+  std::size_t i = 0;
+  // `std::bit_cast` would be a function returning a 256-bit vector outside of the AVX target (`-Wpsabi`)
+  for (; i + 16 <= n; i += 16)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                        __builtin_bit_cast(__m256i, _mm512_cvtneps_pbh(_mm512_loadu_ps(in + i))));
+  narrow_bfloat16_scalar(in + i, n - i, out + i);
+}
+
+// the integer emulation of `float_to_bfloat16` for 8 values
+__attribute__((target("avx2"))) inline __m256i narrow_bfloat16_m256(__m256i x)
+{
+  const __m256i exp_mask = _mm256_set1_epi32(0x7F80'0000);
+  const __m256i abs_mask = _mm256_set1_epi32(0x7FFF'FFFF);
+  const __m256i subnormal = _mm256_cmpeq_epi32(_mm256_and_si256(x, exp_mask), _mm256_setzero_si256());
+  x = _mm256_andnot_si256(_mm256_and_si256(subnormal, abs_mask), x);
+  const __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(x, abs_mask), exp_mask);
+  const __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(1));
+  const __m256i rounded =
+    _mm256_srli_epi32(_mm256_add_epi32(x, _mm256_add_epi32(_mm256_set1_epi32(0x7FFF), lsb)), 16);
+  const __m256i quiet = _mm256_or_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(0x40));
+  return _mm256_blendv_epi8(rounded, quiet, nan);
+}
+
+__attribute__((target("avx2"))) inline void narrow_bfloat16_avx2(const float* in, std::size_t n, std::uint16_t* out)
+{
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m256i lo = narrow_bfloat16_m256(_mm256_castps_si256(_mm256_loadu_ps(in + i)));
+    const __m256i hi = narrow_bfloat16_m256(_mm256_castps_si256(_mm256_loadu_ps(in + i + 8)));
+    // `packus` interleaves the 128-bit lanes of its operands
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                        _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0b11'01'10'00));
+  }
+  narrow_bfloat16_scalar(in + i, n - i, out + i);
+}
+
+__attribute__((target("avx2"))) inline void widen_bfloat16_avx2(const std::uint16_t* in, std::size_t n, float* out)
+{
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256i x = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_slli_epi32(x, 16));
+  }
+  widen_bfloat16_scalar(in + i, n - i, out + i);
+}
+
+__attribute__((target("avx512f"))) inline void widen_bfloat16_avx512(const std::uint16_t* in, std::size_t n,
+                                                                    float* out)
+{
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    _mm512_storeu_si512(out + i, _mm512_maskz_slli_epi32(all_lanes, _mm512_maskz_cvtepu16_epi32(all_lanes, x), 16));
+  }
+  widen_bfloat16_scalar(in + i, n - i, out + i);
+}
+
+#endif
+
+/**
+ * @brief Rounds `n` values from `in` to IEEE 754 binary16 and stores their bits in `out`
+ *
+ * Uses the AVX-512F or F16C conversion instructions if the CPU has them. The results are the same as the ones
+ * of `float_to_binary16`.
+ */
+inline void narrow_binary16(const float* in, std::size_t n, std::uint16_t* out)
+{
+#if MP_UNITS_SIMD
+  if (detected_isa() == isa::avx512) return narrow_binary16_avx512(in, n, out);
+  if (has_f16c()) return narrow_binary16_f16c(in, n, out);
+#endif
+  narrow_binary16_scalar(in, n, out);
+}
+
+/**
+ * @brief Converts `n` IEEE 754 binary16 values from `in` to `float` and stores them in `out`
+ */
+inline void widen_binary16(const std::uint16_t* in, std::size_t n, float* out)
+{
+#if MP_UNITS_SIMD
+  if (detected_isa() == isa::avx512) return widen_binary16_avx512(in, n, out);
+  if (has_f16c()) return widen_binary16_f16c(in, n, out);
+#endif
+  widen_binary16_scalar(in, n, out);
+}
+
+/**
+ * @brief Rounds `n` values from `in` to bfloat16 and stores their bits in `out`
+ *
+ * Uses the AVX-512-BF16 conversion instruction if the CPU has it and its integer emulation with AVX2 otherwise.
+ * The results are the same as the ones of `float_to_bfloat16`.
+ */
+inline void narrow_bfloat16(const float* in, std::size_t n, std::uint16_t* out)
+{
+#if MP_UNITS_SIMD
+  if (has_avx512bf16()) return narrow_bfloat16_avx512bf16(in, n, out);
+  switch (detected_isa()) {
+    case isa::avx512:
+    case isa::avx2:
+      return narrow_bfloat16_avx2(in, n, out);
+    case isa::sse2:
+    case isa::scalar:
+      break;
+  }
+#endif
+  narrow_bfloat16_scalar(in, n, out);
+}
+
+/**
+ * @brief Converts `n` bfloat16 values from `in` to `float` and stores them in `out`
+ */
+inline void widen_bfloat16(const std::uint16_t* in, std::size_t n, float* out)
+{
+#if MP_UNITS_SIMD
+  switch (detected_isa()) {
+    case isa::avx512:
+      return widen_bfloat16_avx512(in, n, out);
+    case isa::avx2:
+      return widen_bfloat16_avx2(in, n, out);
+    case isa::sse2:
+    case isa::scalar:
+      break;
+  }
+#endif
+  widen_bfloat16_scalar(in, n, out);
+}
+
+}  // namespace mp_units::detail::simd
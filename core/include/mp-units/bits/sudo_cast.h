@@ -26,7 +26,21 @@
 #include <mp-units/bits/magnitude.h>
 #include <mp-units/bits/quantity_concepts.h>
 #include <mp-units/bits/reference_concepts.h>
+#include <mp-units/customization_points.h>
 #include <mp-units/unit.h>
+#include <bit>
+#include <climits>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// Set to `1` to scale floating-point values with `long double` multipliers (bit-compatible with previous releases)
+#ifndef MP_UNITS_PRECISE_SCALING
+#define MP_UNITS_PRECISE_SCALING 0
+#endif
 
 namespace mp_units::detail {
 
@@ -42,6 +56,188 @@ template<Quantity From, Quantity To>
     return typename From::rep{};
 }
 
+/**
+ * @brief A conversion factor of a magnitude folded into a single floating-point value
+ *
+ * The factor is computed at compile time with `long double` precision and rounded only once to `T`.
+ * This makes the runtime scaling of a floating-point value a single multiplication in its native precision
+ * (a division by the denominator is replaced with the multiplication by its reciprocal).
+ *
+ * @note The result may differ in the last bit from the one obtained with `MP_UNITS_PRECISE_SCALING` enabled
+ * which scales the value with separate `long double` multipliers for the numerator, denominator, and
+ * irrational part of the magnitude.
+ */
+template<Magnitude auto M, std::floating_point T>
+inline constexpr T fused_conversion_factor = [] {
+  constexpr Magnitude auto num = numerator(M);
+  constexpr Magnitude auto den = denominator(M);
+  constexpr Magnitude auto irr = M * (den / num);
+  return static_cast<T>(get_value<long double>(num) / get_value<long double>(den) * get_value<long double>(irr));
+}();
+
+#if MP_UNITS_HAS_INT128
+__extension__ using max_uint_t = unsigned __int128;
+#else
+using max_uint_t = std::uintmax_t;
+#endif
+
+/**
+ * @brief Compile-time parameters of an unsigned division by a constant
+ *
+ * For every `0 <= x <= XMax` the result of `x * multiplier >> shift` is equal to `x / D` (T. Granlund,
+ * P. Montgomery, "Division by Invariant Integers using Multiplication"). The smallest shift satisfying
+ * `XMax * (multiplier * D - 2^shift) < 2^shift` is selected so that the product is computed in the narrowest
+ * possible type. `encodable` is `false` when the product does not fit in the widest unsigned type available.
+ *
+ * @tparam D a divisor
+ * @tparam XMax the largest dividend to support
+ */
+template<std::uintmax_t D, std::uintmax_t XMax>
+  requires(D > 1)
+struct invariant_divisor {
+private:
+  struct parameters {
+    bool encodable = false;
+    max_uint_t multiplier = 0;
+    int shift = 0;
+  };
+
+  [[nodiscard]] static consteval parameters compute()
+  {
+    constexpr max_uint_t max = ~max_uint_t{0};
+    for (int shift = 0; shift < static_cast<int>(sizeof(max_uint_t) * CHAR_BIT); ++shift) {
+      const max_uint_t p = max_uint_t{1} << shift;
+      const max_uint_t multiplier = p / D + (p % D != 0 ? 1 : 0);
+      const max_uint_t error = multiplier * D - p;
+      if (XMax > max / multiplier) break;  // `x * multiplier` would overflow
+      if (error == 0 || (XMax <= max / error && XMax * error < p)) return {true, multiplier, shift};
+    }
+    return {};
+  }
+
+  static constexpr parameters params = compute();
+
+public:
+  static constexpr bool encodable = params.encodable;
+  static constexpr max_uint_t multiplier = params.multiplier;
+  static constexpr int shift = params.shift;
+  using product_type =
+    conditional<(encodable && XMax <= std::numeric_limits<std::uint64_t>::max() / multiplier), std::uint64_t,
+                max_uint_t>;
+
+  [[nodiscard]] static constexpr std::uintmax_t divide(std::uintmax_t x)
+    requires encodable
+  {
+    return static_cast<std::uintmax_t>((static_cast<product_type>(x) * static_cast<product_type>(multiplier)) >> shift);
+  }
+};
+
+// the largest absolute value of `Rep` multiplied by `Num` (saturated to the range of `std::uintmax_t`)
+template<std::integral Rep, std::uintmax_t Num>
+[[nodiscard]] consteval std::uintmax_t max_abs_product()
+{
+  constexpr auto max_rep = std::is_signed_v<Rep> ? static_cast<std::uintmax_t>(std::numeric_limits<Rep>::max()) + 1
+                                                 : static_cast<std::uintmax_t>(std::numeric_limits<Rep>::max());
+  if (max_rep > std::numeric_limits<std::uintmax_t>::max() / Num) return std::numeric_limits<std::uintmax_t>::max();
+  return max_rep * Num;
+}
+
+/**
+ * @brief Divides an integral value by a constant truncating towards zero
+ *
+ * Uses the multiply-high-and-shift sequence of `invariant_divisor` when it is encodable for dividends not larger
+ * than `XMax` in absolute value, and the built-in division otherwise.
+ *
+ * @tparam D a divisor
+ * @tparam XMax the largest absolute value of a dividend to support
+ */
+template<std::uintmax_t D, std::uintmax_t XMax, std::integral T>
+[[nodiscard]] constexpr T divide_integral(T x)
+{
+  if constexpr (D == 1)
+    return x;
+  else if constexpr (!invariant_divisor<D, XMax>::encodable)
+    return x / static_cast<T>(D);
+  else if constexpr (std::is_signed_v<T>) {
+    // branch-free truncation towards zero: divide the absolute value and restore the sign
+    const std::uintmax_t sign = std::uintmax_t{0} - static_cast<std::uintmax_t>(x < 0);
+    const std::uintmax_t abs_x = (static_cast<std::uintmax_t>(x) ^ sign) - sign;
+    return static_cast<T>((invariant_divisor<D, XMax>::divide(abs_x) ^ sign) - sign);
+  } else
+    return static_cast<T>(invariant_divisor<D, XMax>::divide(x));
+}
+
+/**
+ * @brief Scales an integral value by a rational magnitude
+ *
+ * The intermediate representation is selected at compile time from the range of `FromRep` so that it provably
+ * can't overflow:
+ * - if any value of `FromRep` multiplied by the numerator fits in `std::intmax_t` (`std::uintmax_t` for unsigned
+ *   types), the product is divided by the denominator with `divide_integral` (no branches, no hardware division),
+ * - otherwise, the value is split into a quotient and a remainder of the division by the denominator and both parts
+ *   are scaled separately (`q * num + r * num / den`), which requires only `num * den` to fit,
+ * - otherwise, a 128-bit integer is used if the platform provides it.
+ *
+ * The result is always truncated towards zero, exactly as `value * num / den` computed without an overflow.
+ *
+ * @tparam M a magnitude to scale by
+ * @tparam FromRep the representation type of the source quantity used to limit the range of values to support
+ */
+template<Magnitude auto M, std::integral FromRep, std::integral T>
+  requires(is_rational(M))
+[[nodiscard]] constexpr auto scale_integral(T value)
+{
+  constexpr std::intmax_t num = get_value<std::intmax_t>(numerator(M));
+  constexpr std::intmax_t den = get_value<std::intmax_t>(denominator(M));
+  using x_type = decltype(value * num);
+  constexpr std::uintmax_t from_max = max_abs_product<FromRep, 1>();
+  if constexpr (from_max <= static_cast<std::uintmax_t>(std::numeric_limits<x_type>::max()) / num) {
+    return divide_integral<den, max_abs_product<FromRep, num>()>(value * num);
+  } else if constexpr (num <= std::numeric_limits<std::intmax_t>::max() / den) {
+    const auto q = divide_integral<den, from_max>(static_cast<x_type>(value));
+    const auto r = static_cast<x_type>(value) - q * den;
+    return q * num + divide_integral<den, static_cast<std::uintmax_t>((den - 1) * num)>(r * num);
+  } else {
+#if MP_UNITS_HAS_INT128
+    __extension__ using wide_type = conditional<std::is_signed_v<x_type>, __int128, unsigned __int128>;
+    return static_cast<x_type>(static_cast<wide_type>(value) * num / den);
+#else
+    return value * num / den;
+#endif
+  }
+}
+
+/**
+ * @brief Scales an integral value by a rational magnitude reporting an overflow
+ *
+ * @return the scaled value truncated towards zero or `std::nullopt` if it is not representable in `ToRep`
+ */
+template<Magnitude auto M, std::integral ToRep, std::integral T>
+  requires(is_rational(M)) &&
+          (get_value<std::intmax_t>(numerator(M)) <=
+           std::numeric_limits<std::intmax_t>::max() / get_value<std::intmax_t>(denominator(M)))
+[[nodiscard]] constexpr std::optional<ToRep> checked_scale_integral(T value)
+{
+  using x_type = conditional<std::is_signed_v<T>, std::intmax_t, std::uintmax_t>;
+  constexpr auto num = static_cast<x_type>(get_value<std::intmax_t>(numerator(M)));
+  constexpr auto den = static_cast<x_type>(get_value<std::intmax_t>(denominator(M)));
+  constexpr x_type max = std::numeric_limits<x_type>::max();
+  constexpr x_type min = std::numeric_limits<x_type>::min();
+
+  const x_type q = static_cast<x_type>(value) / den;
+  const x_type r = static_cast<x_type>(value) % den;
+  if (q > max / num) return std::nullopt;
+  if constexpr (std::is_signed_v<x_type>)
+    if (q < min / num) return std::nullopt;
+  const x_type a = q * num;
+  const x_type b = r * num / den;
+  if (b > 0 && a > max - b) return std::nullopt;
+  if constexpr (std::is_signed_v<x_type>)
+    if (b < 0 && a < min - b) return std::nullopt;
+  if (!std::in_range<ToRep>(a + b)) return std::nullopt;
+  return static_cast<ToRep>(a + b);
+}
+
 /**
  * @brief Explicit cast between different quantity types
  *
@@ -70,18 +266,62 @@ template<Quantity To, typename From>
   } else {
     // scale the number
     constexpr Magnitude auto c_mag = get_canonical_unit(q_unit).mag / get_canonical_unit(To::unit).mag;
-    constexpr Magnitude auto num = numerator(c_mag);
-    constexpr Magnitude auto den = denominator(c_mag);
-    constexpr Magnitude auto irr = c_mag * (den / num);
     using c_rep_type = decltype(common_rep_type(q, To{}));
-    using c_mag_type = common_magnitude_type<c_mag>;
-    using multiplier_type =
-      conditional<treat_as_floating_point<c_rep_type>, std::common_type_t<c_mag_type, long double>, c_mag_type>;
-    constexpr auto val = [](Magnitude auto m) { return get_value<multiplier_type>(m); };
-    return static_cast<MP_UNITS_TYPENAME To::rep>(static_cast<c_rep_type>(std::forward<From>(q).numerical_value()) *
-                                                  val(num) / val(den) * val(irr)) *
-           To::reference;
+    using from_rep = std::remove_cvref_t<typename std::remove_reference_t<From>::rep>;
+    if constexpr (c_mag == mag<1>) {
+      // units differ only in name (i.e. `Hz` and `1/s`)
+      return static_cast<MP_UNITS_TYPENAME To::rep>(std::forward<From>(q).numerical_value()) * To::reference;
+    } else if constexpr (requires(const from_rep& v) {
+                           {
+                             scaling_traits<from_rep, typename To::rep>::template scale<c_mag>(v)
+                           } -> std::same_as<typename To::rep>;
+                         }) {
+      // a representation type providing its own scaling
+      return scaling_traits<from_rep, typename To::rep>::template scale<c_mag>(std::forward<From>(q).numerical_value()) *
+             To::reference;
+    } else if constexpr (std::is_floating_point_v<c_rep_type> && !MP_UNITS_PRECISE_SCALING) {
+      return static_cast<MP_UNITS_TYPENAME To::rep>(static_cast<c_rep_type>(std::forward<From>(q).numerical_value()) *
+                                                    fused_conversion_factor<c_mag, c_rep_type>) *
+             To::reference;
+    } else if constexpr (std::is_integral_v<c_rep_type> && is_rational(c_mag) &&
+                         requires { scale_integral<c_mag, typename std::remove_reference_t<From>::rep>(c_rep_type{}); }) {
+      // overflow-safe integral scaling without a hardware division
+      return static_cast<MP_UNITS_TYPENAME To::rep>(scale_integral<c_mag, typename std::remove_reference_t<From>::rep>(
+               static_cast<c_rep_type>(std::forward<From>(q).numerical_value()))) *
+             To::reference;
+    } else {
+      constexpr Magnitude auto num = numerator(c_mag);
+      constexpr Magnitude auto den = denominator(c_mag);
+      constexpr Magnitude auto irr = c_mag * (den / num);
+      using c_mag_type = common_magnitude_type<c_mag>;
+      using multiplier_type =
+        conditional<treat_as_floating_point<c_rep_type>, std::common_type_t<c_mag_type, long double>, c_mag_type>;
+      constexpr auto val = [](Magnitude auto m) { return get_value<multiplier_type>(m); };
+      return static_cast<MP_UNITS_TYPENAME To::rep>(static_cast<c_rep_type>(std::forward<From>(q).numerical_value()) *
+                                                    val(num) / val(den) * val(irr)) *
+             To::reference;
+    }
   }
 }
 
+/**
+ * @brief Explicit cast between quantity types with integral representations that reports an overflow
+ *
+ * @return the converted quantity or `std::nullopt` if its value is not representable in `To::rep`
+ */
+template<Quantity To, Quantity From>
+  requires(castable(From::quantity_spec, To::quantity_spec)) && std::integral<typename From::rep> &&
+          std::integral<typename To::rep> &&
+          requires(typename From::rep v) {
+            checked_scale_integral<get_canonical_unit(From::unit).mag / get_canonical_unit(To::unit).mag,
+                                   typename To::rep>(v);
+          }
+[[nodiscard]] constexpr std::optional<To> checked_sudo_cast(const From& q)
+{
+  constexpr Magnitude auto c_mag = get_canonical_unit(From::unit).mag / get_canonical_unit(To::unit).mag;
+  if (const auto v = checked_scale_integral<c_mag, typename To::rep>(q.numerical_value()))
+    return make_quantity<To::reference>(*v);
+  return std::nullopt;
+}
+
 }  // namespace mp_units::detail
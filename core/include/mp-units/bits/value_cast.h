@@ -27,9 +27,24 @@
 #include <mp-units/bits/sudo_cast.h>
 #include <mp-units/bits/unit_concepts.h>
 #include <mp-units/reference.h>
+#include <optional>
 
 namespace mp_units {
 
+namespace detail {
+
+template<typename Q, Unit auto ToU>
+[[nodiscard]] consteval Reference auto value_cast_reference()
+{
+  if constexpr (is_specialization_of_reference<std::remove_const_t<decltype(Q::reference)>>::value ||
+                !AssociatedUnit<std::remove_const_t<decltype(ToU)>>)
+    return reference<Q::quantity_spec, ToU>{};
+  else
+    return ToU;
+}
+
+}  // namespace detail
+
 /**
  * @brief Explicit cast of a quantity's unit
  *
@@ -45,13 +60,7 @@ template<Unit auto ToU, typename Q>
   requires Quantity<std::remove_cvref_t<Q>> && (convertible(std::remove_reference_t<Q>::reference, ToU))
 {
   using q_type = std::remove_reference_t<Q>;
-  constexpr auto r = [] {
-    if constexpr (detail::is_specialization_of_reference<std::remove_const_t<decltype(q_type::reference)>>::value ||
-                  !AssociatedUnit<std::remove_const_t<decltype(ToU)>>)
-      return reference<q_type::quantity_spec, ToU>{};
-    else
-      return ToU;
-  }();
+  constexpr auto r = detail::value_cast_reference<q_type, ToU>();
   return detail::sudo_cast<quantity<r, typename q_type::rep>>(std::forward<Q>(q));
 }
 
@@ -74,4 +83,42 @@ template<Representation ToRep, typename Q>
   return detail::sudo_cast<quantity<std::remove_reference_t<Q>::reference, ToRep>>(std::forward<Q>(q));
 }
 
+/**
+ * @brief Explicit cast of a quantity's unit that reports an overflow
+ *
+ * Works like `value_cast` for quantities with integral representation types but the scaling is done
+ * without any intermediate overflow and `std::nullopt` is returned instead of a wrapped-around value if
+ * the result is not representable in the representation type.
+ *
+ * if (auto d = try_value_cast<si::nano<si::metre>>(q)) ...
+ *
+ * @tparam ToU a unit to use for a target quantity
+ */
+template<Unit auto ToU, typename Q>
+  requires Quantity<Q> && (convertible(Q::reference, ToU)) && requires(Q q) {
+    detail::checked_sudo_cast<quantity<detail::value_cast_reference<Q, ToU>(), typename Q::rep>>(q);
+  }
+[[nodiscard]] constexpr std::optional<quantity<detail::value_cast_reference<Q, ToU>(), typename Q::rep>> try_value_cast(
+  const Q& q)
+{
+  return detail::checked_sudo_cast<quantity<detail::value_cast_reference<Q, ToU>(), typename Q::rep>>(q);
+}
+
+/**
+ * @brief Explicit cast of a quantity's representation type that reports an overflow
+ *
+ * Returns `std::nullopt` instead of a wrapped-around value if the value is not representable in `ToRep`.
+ *
+ * if (auto q16 = try_value_cast<std::int16_t>(q)) ...
+ *
+ * @tparam ToRep an integral representation type to use for a target quantity
+ */
+template<Representation ToRep, typename Q>
+  requires Quantity<Q> && RepresentationOf<ToRep, Q::quantity_spec.character> &&
+           requires(Q q) { detail::checked_sudo_cast<quantity<Q::reference, ToRep>>(q); }
+[[nodiscard]] constexpr std::optional<quantity<Q::reference, ToRep>> try_value_cast(const Q& q)
+{
+  return detail::checked_sudo_cast<quantity<Q::reference, ToRep>>(q);
+}
+
 }  // namespace mp_units
@@ -132,6 +132,21 @@ struct quantity_values {
   }
 };
 
+/**
+ * @brief Customizes the scaling of a numerical value in a conversion between units
+ *
+ * By default, the library scales the value of a quantity with multiplications and divisions in the common
+ * type of the source and destination representation types. This type trait can be specialized for a custom
+ * representation type that can do better (i.e. a fixed-point number that folds the shift of its binary point
+ * into the scaling). The specialization should provide a static member function template
+ * `template<Magnitude auto M> static To scale(const From& v)` that returns `v` multiplied by `M`.
+ *
+ * @tparam From a representation type of the source quantity
+ * @tparam To a representation type of the destination quantity
+ */
+template<typename From, typename To>
+struct scaling_traits {};
+
 /**
  * @brief Provides support for external quantity-like types
  *
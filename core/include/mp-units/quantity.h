@@ -32,7 +32,12 @@
 #include <mp-units/bits/unit_concepts.h>
 #include <mp-units/customization_points.h>
 #include <mp-units/reference.h>
+#include <climits>
 #include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 #include <utility>
 
 // the below is not used in this header but should be exposed with it
@@ -71,6 +76,93 @@ template<typename Func, Quantity Q1, Quantity Q2>
 using common_quantity_for = quantity<common_reference(Q1::reference, Q2::reference),
                                      std::invoke_result_t<Func, typename Q1::rep, typename Q2::rep>>;
 
+#if MP_UNITS_HAS_INT128
+__extension__ using max_cross_product_type = __int128;
+__extension__ using max_cross_product_utype = unsigned __int128;
+#else
+using max_cross_product_type = std::intmax_t;
+using max_cross_product_utype = std::uintmax_t;
+#endif
+
+// `true` if any value of `Rep` multiplied by `k` fits in `T`
+template<std::integral Rep, typename T>
+[[nodiscard]] consteval bool fits_cross_product(std::uintmax_t k)
+{
+  using wide_type = max_cross_product_utype;
+  constexpr auto max_rep = std::is_signed_v<Rep> ? static_cast<wide_type>(std::numeric_limits<Rep>::max()) + 1
+                                                 : static_cast<wide_type>(std::numeric_limits<Rep>::max());
+  constexpr auto max_t = (wide_type{1} << (sizeof(T) * CHAR_BIT - 1)) - 1;
+  return max_rep <= max_t / k;
+}
+
+// the narrowest type in which `a * numerator(M)` and `b * denominator(M)` can be compared exactly
+// (`void` if there is no such type)
+template<Magnitude auto M, typename Rep1, typename Rep2>
+[[nodiscard]] consteval auto cross_product_type()
+{
+  if constexpr (std::integral<Rep1> && std::integral<Rep2> && is_rational(M)) {
+    constexpr auto limit = static_cast<long double>(std::numeric_limits<std::intmax_t>::max());
+    if constexpr (get_value<long double>(numerator(M)) > limit || get_value<long double>(denominator(M)) > limit)
+      return std::type_identity<void>{};
+    else {
+      constexpr auto num = get_value<std::uintmax_t>(numerator(M));
+      constexpr auto den = get_value<std::uintmax_t>(denominator(M));
+      if constexpr (fits_cross_product<Rep1, std::intmax_t>(num) && fits_cross_product<Rep2, std::intmax_t>(den))
+        return std::type_identity<std::intmax_t>{};
+      else if constexpr (fits_cross_product<Rep1, max_cross_product_type>(num) &&
+                         fits_cross_product<Rep2, max_cross_product_type>(den))
+        return std::type_identity<max_cross_product_type>{};
+      else
+        return std::type_identity<void>{};
+    }
+  } else
+    return std::type_identity<void>{};
+}
+
+/**
+ * @brief Values of two quantities that compare the same as the quantities do
+ *
+ * The quantities are not converted to their common unit, which may need two scalings and overflow for units with
+ * an awkward common unit (i.e. `ft` and `m`):
+ * - integral values are cross-multiplied by the numerator and denominator of the ratio of the units in a widened
+ *   type, which is exact (also for operands of different signedness, even in the same unit, so `-1 * m` no longer
+ *   compares equal to `4294967295u * m` as it did when both values were converted to the common `unsigned`
+ *   representation type),
+ * - floating-point values are compared after scaling only one of them to the unit of the other one (the one
+ *   expressed in a larger unit, so the scaling is a multiplication by an integral factor when possible).
+ *
+ * Other representation types (and all of them if `MP_UNITS_PRECISE_SCALING` is enabled) are compared in the common
+ * quantity type.
+ */
+template<Quantity Q1, Quantity Q2>
+[[nodiscard]] constexpr auto comparison_operands(const Q1& lhs, const Q2& rhs)
+{
+  using rep1 = typename Q1::rep;
+  using rep2 = typename Q2::rep;
+  using ct = std::common_type_t<Q1, Q2>;
+  using c_rep = typename ct::rep;
+  constexpr Magnitude auto m = get_canonical_unit(Q1::unit).mag / get_canonical_unit(Q2::unit).mag;
+  using x_type = typename decltype(cross_product_type<m, rep1, rep2>())::type;
+  if constexpr (m == mag<1> && std::is_arithmetic_v<c_rep> &&
+                !(std::integral<rep1> && std::integral<rep2> && std::is_signed_v<rep1> != std::is_signed_v<rep2>))
+    return std::pair{static_cast<c_rep>(lhs.numerical_value()), static_cast<c_rep>(rhs.numerical_value())};
+  else if constexpr (!std::is_void_v<x_type>) {
+    constexpr auto num = static_cast<x_type>(get_value<std::intmax_t>(numerator(m)));
+    constexpr auto den = static_cast<x_type>(get_value<std::intmax_t>(denominator(m)));
+    return std::pair{static_cast<x_type>(lhs.numerical_value()) * num,
+                     static_cast<x_type>(rhs.numerical_value()) * den};
+  } else if constexpr (std::floating_point<c_rep> && std::is_arithmetic_v<rep1> && std::is_arithmetic_v<rep2> &&
+                       !MP_UNITS_PRECISE_SCALING) {
+    if constexpr (!is_integral(m) && is_integral(mag<1> / m))
+      return std::pair{static_cast<c_rep>(lhs.numerical_value()),
+                       static_cast<c_rep>(rhs.numerical_value()) * fused_conversion_factor<mag<1> / m, c_rep>};
+    else
+      return std::pair{static_cast<c_rep>(lhs.numerical_value()) * fused_conversion_factor<m, c_rep>,
+                       static_cast<c_rep>(rhs.numerical_value())};
+  } else
+    return std::pair{ct(lhs).numerical_value(), ct(rhs).numerical_value()};
+}
+
 }  // namespace detail
 
 /**
@@ -353,6 +445,91 @@ template<auto R1, typename Rep1, auto R2, typename Rep2>
   return make_quantity<ret::reference>(ret(lhs).numerical_value() - ret(rhs).numerical_value());
 }
 
+/**
+ * @brief Policies selecting the unit of the result of `add` and `subtract`
+ *
+ * - `common` - the common unit of both operands (the one used by `operator+` and `operator-`); for units that are
+ *   not integral multiples of each other (i.e. `ft` and `m`) both operands are scaled,
+ * - `lhs`/`rhs` - the unit of the respective operand; only the other operand is scaled,
+ * - `fewest_scalings` - the finer unit if one unit is an integral multiple of the other one, so only the other
+ *   operand is scaled; otherwise the unit of `lhs` for floating-point representation types (i.e. accumulators),
+ *   so only `rhs` is scaled, and the common unit for integral ones (which would be truncated otherwise), so both
+ *   operands are scaled as for `common`.
+ */
+namespace result_unit {
+
+struct common {};
+struct lhs {};
+struct rhs {};
+struct fewest_scalings {};
+
+}  // namespace result_unit
+
+template<typename T>
+concept ResultUnitPolicy = is_same_v<T, result_unit::common> || is_same_v<T, result_unit::lhs> ||
+                           is_same_v<T, result_unit::rhs> || is_same_v<T, result_unit::fewest_scalings>;
+
+namespace detail {
+
+template<ResultUnitPolicy Policy, typename Func, Quantity Q1, Quantity Q2>
+[[nodiscard]] consteval Unit auto result_unit_for()
+{
+  constexpr Unit auto common = get_unit(common_reference(Q1::reference, Q2::reference));
+  constexpr Magnitude auto m = get_canonical_unit(Q1::unit).mag / get_canonical_unit(Q2::unit).mag;
+  if constexpr (is_same_v<Policy, result_unit::lhs>)
+    return Q1::unit;
+  else if constexpr (is_same_v<Policy, result_unit::rhs>)
+    return Q2::unit;
+  else if constexpr (is_same_v<Policy, result_unit::fewest_scalings> && !is_integral(m) &&
+                     !is_integral(mag<1> / m) &&
+                     treat_as_floating_point<std::invoke_result_t<Func, typename Q1::rep, typename Q2::rep>>)
+    return Q1::unit;
+  else
+    return common;
+}
+
+template<ResultUnitPolicy Policy, typename Func, Quantity Q1, Quantity Q2>
+  requires detail::InvocableQuantities<Func, Q1, Q2>
+using result_quantity_for = quantity<clone_reference_with<result_unit_for<Policy, Func, Q1, Q2>()>(
+                                       common_reference(Q1::reference, Q2::reference)),
+                                     std::invoke_result_t<Func, typename Q1::rep, typename Q2::rep>>;
+
+template<typename Policy, typename Func, typename Q1, typename Q2>
+concept InvocableQuantitiesIn =
+  ResultUnitPolicy<Policy> && InvocableQuantities<Func, Q1, Q2> &&
+  std::constructible_from<result_quantity_for<Policy, Func, Q1, Q2>, Q1> &&
+  std::constructible_from<result_quantity_for<Policy, Func, Q1, Q2>, Q2>;
+
+}  // namespace detail
+
+/**
+ * @brief Adds two quantities and returns the result in the unit selected by `Policy`
+ *
+ * The operand already expressed in the result unit is not scaled, i.e. `add<result_unit::lhs>(acc, 1 * m)` for
+ * `acc` in `ft` scales only the second operand while `acc + 1 * m` scales both of them (and the result is expressed
+ * in `m / 1250`).
+ */
+template<typename Policy = result_unit::common, auto R1, typename Rep1, auto R2, typename Rep2>
+  requires detail::InvocableQuantitiesIn<Policy, std::plus<>, quantity<R1, Rep1>, quantity<R2, Rep2>>
+[[nodiscard]] constexpr Quantity auto add(const quantity<R1, Rep1>& lhs, const quantity<R2, Rep2>& rhs)
+{
+  using ret = detail::result_quantity_for<Policy, std::plus<>, quantity<R1, Rep1>, quantity<R2, Rep2>>;
+  return make_quantity<ret::reference>(ret(lhs).numerical_value() + ret(rhs).numerical_value());
+}
+
+/**
+ * @brief Subtracts two quantities and returns the result in the unit selected by `Policy`
+ *
+ * @see add
+ */
+template<typename Policy = result_unit::common, auto R1, typename Rep1, auto R2, typename Rep2>
+  requires detail::InvocableQuantitiesIn<Policy, std::minus<>, quantity<R1, Rep1>, quantity<R2, Rep2>>
+[[nodiscard]] constexpr Quantity auto subtract(const quantity<R1, Rep1>& lhs, const quantity<R2, Rep2>& rhs)
+{
+  using ret = detail::result_quantity_for<Policy, std::minus<>, quantity<R1, Rep1>, quantity<R2, Rep2>>;
+  return make_quantity<ret::reference>(ret(lhs).numerical_value() - ret(rhs).numerical_value());
+}
+
 template<auto R1, typename Rep1, auto R2, typename Rep2>
   requires(!treat_as_floating_point<Rep1>) && (!treat_as_floating_point<Rep2>) &&
           detail::InvocableQuantities<std::modulus<>, quantity<R1, Rep1>, quantity<R2, Rep2>>
@@ -417,8 +594,8 @@ template<auto R1, typename Rep1, auto R2, typename Rep2>
            std::equality_comparable<typename std::common_type_t<quantity<R1, Rep1>, quantity<R2, Rep2>>::rep>
 [[nodiscard]] constexpr bool operator==(const quantity<R1, Rep1>& lhs, const quantity<R2, Rep2>& rhs)
 {
-  using ct = std::common_type_t<quantity<R1, Rep1>, quantity<R2, Rep2>>;
-  return ct(lhs).numerical_value() == ct(rhs).numerical_value();
+  const auto [l, r] = detail::comparison_operands(lhs, rhs);
+  return l == r;
 }
 
 template<auto R1, typename Rep1, auto R2, typename Rep2>
@@ -426,8 +603,8 @@ template<auto R1, typename Rep1, auto R2, typename Rep2>
            std::three_way_comparable<typename std::common_type_t<quantity<R1, Rep1>, quantity<R2, Rep2>>::rep>
 [[nodiscard]] constexpr auto operator<=>(const quantity<R1, Rep1>& lhs, const quantity<R2, Rep2>& rhs)
 {
-  using ct = std::common_type_t<quantity<R1, Rep1>, quantity<R2, Rep2>>;
-  return ct(lhs).numerical_value() <=> ct(rhs).numerical_value();
+  const auto [l, r] = detail::comparison_operands(lhs, rhs);
+  return l <=> r;
 }
 
 // make_quantity
@@ -0,0 +1,258 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/external/type_traits.h>
+#include <mp-units/bits/magnitude.h>
+#include <mp-units/bits/quantity_concepts.h>
+#include <mp-units/bits/sudo_cast.h>
+#include <mp-units/quantity.h>
+#include <mp-units/unit.h>
+#include <concepts>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace mp_units {
+
+template<typename Node>
+class quantity_expression;
+
+namespace detail {
+
+template<typename T>
+inline constexpr bool is_quantity_expression = is_specialization_of<T, quantity_expression>;
+
+}  // namespace detail
+
+/**
+ * @brief A concept matching lazily evaluated quantity expressions
+ */
+template<typename T>
+concept QuantityExpression = detail::is_quantity_expression<std::remove_cvref_t<T>>;
+
+namespace detail {
+
+/**
+ * @brief Scales a numerical value by a magnitude known at compile time
+ *
+ * Uses the same scaling kernels as `sudo_cast` (a fused floating-point factor or an integral
+ * multiply-and-shift), so a lazily evaluated expression is not less accurate than an eager one.
+ */
+template<Magnitude auto M, typename Rep, typename T>
+[[nodiscard]] constexpr Rep scale_value(const T& v)
+{
+  if constexpr (M == mag<1>)
+    return static_cast<Rep>(v);
+  else
+    return sudo_cast<quantity<one, Rep>>(make_quantity<M * one>(static_cast<Rep>(v))).numerical_value();
+}
+
+// the magnitude converting a value expressed in `From` to the one expressed in `To`
+template<Unit auto From, Unit auto To>
+inline constexpr Magnitude auto conversion_magnitude = get_canonical_unit(From).mag / get_canonical_unit(To).mag;
+
+// The nodes of the expression tree provide the type of a quantity an eager evaluation would return (`result`)
+// and compute their numerical value in the unit of `result` scaled by `M`. The magnitude is pushed down the tree
+// (through both operands of a sum and the first operand of a product) so that every leaf is scaled at most once.
+
+template<Quantity Q>
+struct expression_leaf {
+  using result = Q;
+  Q q;
+
+  template<Magnitude auto M, typename Rep>
+  [[nodiscard]] constexpr Rep value() const
+  {
+    return scale_value<M, Rep>(q.numerical_value());
+  }
+};
+
+template<typename Op, typename Lhs, typename Rhs>
+struct expression_sum {
+  using result = decltype(Op{}(std::declval<typename Lhs::result>(), std::declval<typename Rhs::result>()));
+  Lhs lhs;
+  Rhs rhs;
+
+  template<Magnitude auto M, typename Rep>
+  [[nodiscard]] constexpr Rep value() const
+  {
+    return Op{}(lhs.template value<M * conversion_magnitude<Lhs::result::unit, result::unit>, Rep>(),
+                rhs.template value<M * conversion_magnitude<Rhs::result::unit, result::unit>, Rep>());
+  }
+};
+
+template<typename Op, typename Lhs, typename Rhs>
+struct expression_product {
+  using result = decltype(Op{}(std::declval<typename Lhs::result>(), std::declval<typename Rhs::result>()));
+  Lhs lhs;
+  Rhs rhs;
+
+  template<Magnitude auto M, typename Rep>
+  [[nodiscard]] constexpr Rep value() const
+  {
+    return Op{}(lhs.template value<M, Rep>(), rhs.template value<mag<1>, Rep>());
+  }
+};
+
+template<Quantity Q>
+[[nodiscard]] constexpr expression_leaf<Q> make_expression_node(const Q& q)
+{
+  return {q};
+}
+
+template<typename Node>
+[[nodiscard]] constexpr const Node& make_expression_node(const quantity_expression<Node>& e)
+{
+  return e.node();
+}
+
+template<typename Value>
+  requires(!Quantity<Value>) && (!QuantityExpression<Value>)
+[[nodiscard]] constexpr expression_leaf<quantity<one, Value>> make_expression_node(const Value& v)
+{
+  return {make_quantity<one>(v)};
+}
+
+template<typename T>
+using expression_node_t = std::remove_cvref_t<decltype(make_expression_node(std::declval<const T&>()))>;
+
+template<typename Op, typename Lhs, typename Rhs>
+concept InvocableExpressionOperands =
+  std::invocable<Op, typename expression_node_t<Lhs>::result, typename expression_node_t<Rhs>::result>;
+
+template<template<typename, typename, typename> typename Node, typename Op, typename Lhs, typename Rhs>
+[[nodiscard]] constexpr auto make_expression(const Lhs& lhs, const Rhs& rhs)
+{
+  using node = Node<Op, expression_node_t<Lhs>, expression_node_t<Rhs>>;
+  return quantity_expression<node>(node{make_expression_node(lhs), make_expression_node(rhs)});
+}
+
+template<typename Lhs, typename Rhs>
+concept ExpressionOperands =
+  (QuantityExpression<Lhs> && (QuantityExpression<Rhs> || Quantity<Rhs>)) || (Quantity<Lhs> && QuantityExpression<Rhs>);
+
+template<typename Lhs, typename Rhs>
+concept ExpressionAndValue =
+  (QuantityExpression<Lhs> && !Quantity<Rhs> && !QuantityExpression<Rhs>) ||
+  (QuantityExpression<Rhs> && !Quantity<Lhs> && !QuantityExpression<Lhs>);
+
+}  // namespace detail
+
+/**
+ * @brief A lazily evaluated quantity expression
+ *
+ * Captures the operand tree of a chain of quantity arithmetic instead of computing the intermediate quantities.
+ * When the expression is materialized in a concrete unit, a single magnitude converting the unit of the whole
+ * expression to the requested one is computed at compile time and applied once to the operands (for a product or
+ * a quotient only its first operand is scaled). This removes the intermediate roundings and redundant multiplications
+ * of the eager evaluation, i.e. in `(lazy(d1) + d2).in(si::milli<si::metre>)` with `d1` in kilometres and `d2` in
+ * metres every distance is scaled only once.
+ *
+ * The expression is materialized with `in(U)`, with a conversion to a quantity type, or with `evaluate()`
+ * (returning the same quantity type as an eager computation). All the computations are done in the representation
+ * type of the materialized quantity.
+ *
+ * @tparam Node the root node of the expression tree
+ */
+template<typename Node>
+class quantity_expression {
+  Node node_;
+
+public:
+  using result = typename Node::result;
+  static constexpr Reference auto reference = result::reference;
+  static constexpr QuantitySpec auto quantity_spec = result::quantity_spec;
+  static constexpr Unit auto unit = result::unit;
+  using rep = typename result::rep;
+
+  constexpr explicit quantity_expression(const Node& n) : node_(n) {}
+
+  [[nodiscard]] constexpr const Node& node() const noexcept { return node_; }
+
+  [[nodiscard]] constexpr result evaluate() const
+  {
+    return make_quantity<reference>(node_.template value<mag<1>, rep>());
+  }
+
+  template<Unit U>
+    requires detail::QuantityConvertibleTo<result, quantity<quantity_spec[U{}], rep>>
+  [[nodiscard]] constexpr quantity<quantity_spec[U{}], rep> in(U) const
+  {
+    return make_quantity<quantity_spec[U{}]>(
+      node_.template value<detail::conversion_magnitude<unit, U{}>, rep>());
+  }
+
+  template<Quantity Q>
+    requires detail::QuantityConvertibleTo<result, Q>
+  constexpr operator Q() const
+  {
+    return make_quantity<Q::reference>(
+      node_.template value<detail::conversion_magnitude<unit, Q::unit>, typename Q::rep>());
+  }
+};
+
+/**
+ * @brief Starts a lazily evaluated quantity expression
+ */
+template<auto R, typename Rep>
+[[nodiscard]] constexpr quantity_expression<detail::expression_leaf<quantity<R, Rep>>> lazy(const quantity<R, Rep>& q)
+{
+  return quantity_expression<detail::expression_leaf<quantity<R, Rep>>>({q});
+}
+
+// clang-format off
+template<typename Lhs, typename Rhs>
+  requires detail::ExpressionOperands<Lhs, Rhs> &&
+           detail::InvocableExpressionOperands<std::plus<>, Lhs, Rhs>
+[[nodiscard]] constexpr QuantityExpression auto operator+(const Lhs& lhs, const Rhs& rhs)
+{
+  return detail::make_expression<detail::expression_sum, std::plus<>>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs>
+  requires detail::ExpressionOperands<Lhs, Rhs> &&
+           detail::InvocableExpressionOperands<std::minus<>, Lhs, Rhs>
+[[nodiscard]] constexpr QuantityExpression auto operator-(const Lhs& lhs, const Rhs& rhs)
+{
+  return detail::make_expression<detail::expression_sum, std::minus<>>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs>
+  requires(detail::ExpressionOperands<Lhs, Rhs> || detail::ExpressionAndValue<Lhs, Rhs>) &&
+          detail::InvocableExpressionOperands<std::multiplies<>, Lhs, Rhs>
+[[nodiscard]] constexpr QuantityExpression auto operator*(const Lhs& lhs, const Rhs& rhs)
+{
+  return detail::make_expression<detail::expression_product, std::multiplies<>>(lhs, rhs);
+}
+
+template<typename Lhs, typename Rhs>
+  requires(detail::ExpressionOperands<Lhs, Rhs> || detail::ExpressionAndValue<Lhs, Rhs>) &&
+          detail::InvocableExpressionOperands<std::divides<>, Lhs, Rhs>
+[[nodiscard]] constexpr QuantityExpression auto operator/(const Lhs& lhs, const Rhs& rhs)
+{
+  return detail::make_expression<detail::expression_product, std::divides<>>(lhs, rhs);
+}
+// clang-format on
+
+}  // namespace mp_units
@@ -0,0 +1,376 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <mp-units/bits/quantity_concepts.h>
+#include <mp-units/quantity.h>
+#include <mp-units/quantity_span.h>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mp_units {
+
+template<Quantity... Qs>
+  requires(sizeof...(Qs) > 0)
+class quantity_soa;
+
+/**
+ * @brief A proxy to a row of a `quantity_soa` container
+ *
+ * Behaves like an aggregate of quantity references. Individual fields are accessed with `get<I>()` (also through
+ * structured bindings), and the whole row can be read as or assigned from `std::tuple<Qs...>`.
+ *
+ * @tparam Const `true` for a read-only row
+ */
+template<bool Const, Quantity... Qs>
+class quantity_soa_row {
+  using container = std::conditional_t<Const, const quantity_soa<Qs...>, quantity_soa<Qs...>>;
+  container* soa_;
+  std::size_t idx_;
+
+  template<std::size_t... Is>
+  constexpr void assign(const std::tuple<Qs...>& values, std::index_sequence<Is...>) const
+  {
+    ((get<Is>() = std::get<Is>(values)), ...);
+  }
+
+  template<std::size_t... Is>
+  [[nodiscard]] constexpr std::tuple<Qs...> values(std::index_sequence<Is...>) const
+  {
+    return std::tuple<Qs...>(get<Is>().get()...);
+  }
+
+public:
+  using value_type = std::tuple<Qs...>;
+
+  constexpr quantity_soa_row(container& soa, std::size_t idx) noexcept : soa_(&soa), idx_(idx) {}
+  quantity_soa_row(const quantity_soa_row&) = default;
+
+  template<std::size_t I>
+  [[nodiscard]] constexpr auto get() const
+  {
+    return soa_->template column<I>()[idx_];
+  }
+
+  // assignment modifies the referenced values (not the reference itself)
+  constexpr const quantity_soa_row& operator=(const quantity_soa_row& other) const
+    requires(!Const)
+  {
+    assign(other, std::index_sequence_for<Qs...>{});
+    return *this;
+  }
+
+  constexpr const quantity_soa_row& operator=(const value_type& values) const
+    requires(!Const)
+  {
+    assign(values, std::index_sequence_for<Qs...>{});
+    return *this;
+  }
+
+  [[nodiscard]] constexpr operator value_type() const { return values(std::index_sequence_for<Qs...>{}); }
+
+  [[nodiscard]] friend constexpr bool operator==(const quantity_soa_row& lhs, const value_type& rhs)
+  {
+    return static_cast<value_type>(lhs) == rhs;
+  }
+};
+
+/**
+ * @brief A structure-of-arrays container of quantity records
+ *
+ * Stores every field of a record in a separate contiguous column of numerical values, so kernels that touch only
+ * some of the fields do not waste cache bandwidth on the others. Columns are exposed as `quantity_span` views,
+ * and rows as `quantity_soa_row` proxies.
+ *
+ * quantity_soa<quantity<isq::length[m]>, quantity<isq::speed[m / s]>, quantity<si::kilogram, float>> bodies;
+ * bodies.push_back(1 * m, 2 * (m / s), 3.f * kg);
+ * auto momentum = bodies.column<1>() * bodies.column<2>();
+ *
+ * @tparam Qs quantity types of the fields of a record (a `quantity<R, Rep>` carries both the reference and the
+ *            representation type of a field, which could not be interleaved in a single template parameter list)
+ */
+template<Quantity... Qs>
+  requires(sizeof...(Qs) > 0)
+class quantity_soa {
+  std::tuple<std::vector<typename Qs::rep>...> columns_;
+
+  template<std::size_t... Is>
+  constexpr void push_back_impl(std::index_sequence<Is...>, const Qs&... qs)
+  {
+    (std::get<Is>(columns_).push_back(qs.numerical_value()), ...);
+  }
+
+public:
+  // member types and values
+  static constexpr std::size_t field_count = sizeof...(Qs);
+  template<std::size_t I>
+  using field_type = std::tuple_element_t<I, std::tuple<Qs...>>;
+  using value_type = std::tuple<Qs...>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using row_reference = quantity_soa_row<false, Qs...>;
+  using const_row_reference = quantity_soa_row<true, Qs...>;
+
+  template<bool Const>
+  class iterator_impl;
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+  // construction, assignment, destruction
+  quantity_soa() = default;
+  constexpr explicit quantity_soa(size_type count) { resize(count); }
+
+  // capacity
+  [[nodiscard]] constexpr size_type size() const noexcept { return std::get<0>(columns_).size(); }
+  [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+
+  constexpr void reserve(size_type new_cap)
+  {
+    std::apply([&](auto&... cols) { (cols.reserve(new_cap), ...); }, columns_);
+  }
+
+  constexpr void resize(size_type count)
+  {
+    std::apply([&](auto&... cols) { (cols.resize(count), ...); }, columns_);
+  }
+
+  // modifiers
+  constexpr void clear() noexcept
+  {
+    std::apply([](auto&... cols) { (cols.clear(), ...); }, columns_);
+  }
+
+  constexpr void push_back(const Qs&... qs) { push_back_impl(std::index_sequence_for<Qs...>{}, qs...); }
+
+  constexpr void push_back(const value_type& values)
+  {
+    std::apply([&](const Qs&... qs) { push_back(qs...); }, values);
+  }
+
+  constexpr void pop_back()
+  {
+    gsl_ExpectsAudit(!empty());
+    std::apply([](auto&... cols) { (cols.pop_back(), ...); }, columns_);
+  }
+
+  // column access
+  template<std::size_t I>
+  [[nodiscard]] constexpr quantity_span<field_type<I>::reference, typename field_type<I>::rep> column() noexcept
+  {
+    return quantity_span<field_type<I>::reference, typename field_type<I>::rep>(std::get<I>(columns_));
+  }
+
+  template<std::size_t I>
+  [[nodiscard]] constexpr quantity_span<field_type<I>::reference, const typename field_type<I>::rep> column()
+    const noexcept
+  {
+    return quantity_span<field_type<I>::reference, const typename field_type<I>::rep>(std::get<I>(columns_));
+  }
+
+  // row access
+  [[nodiscard]] constexpr row_reference operator[](size_type idx)
+  {
+    gsl_ExpectsAudit(idx < size());
+    return row_reference(*this, idx);
+  }
+
+  [[nodiscard]] constexpr const_row_reference operator[](size_type idx) const
+  {
+    gsl_ExpectsAudit(idx < size());
+    return const_row_reference(*this, idx);
+  }
+
+  // iterators
+  [[nodiscard]] constexpr iterator begin() noexcept { return iterator(*this, 0); }
+  [[nodiscard]] constexpr iterator end() noexcept { return iterator(*this, size()); }
+  [[nodiscard]] constexpr const_iterator begin() const noexcept { return const_iterator(*this, 0); }
+  [[nodiscard]] constexpr const_iterator end() const noexcept { return const_iterator(*this, size()); }
+};
+
+/**
+ * @brief A random access iterator over the rows of a `quantity_soa` container
+ */
+template<Quantity... Qs>
+  requires(sizeof...(Qs) > 0)
+template<bool Const>
+class quantity_soa<Qs...>::iterator_impl {
+public:
+  using iterator_concept = std::random_access_iterator_tag;
+  using iterator_category = std::input_iterator_tag;
+  using value_type = std::tuple<Qs...>;
+  using difference_type = std::ptrdiff_t;
+  using reference = quantity_soa_row<Const, Qs...>;
+
+private:
+  using container = std::conditional_t<Const, const quantity_soa, quantity_soa>;
+  container* soa_ = nullptr;
+  difference_type idx_ = 0;
+
+public:
+
+  iterator_impl() = default;
+  constexpr iterator_impl(container& soa, size_type idx) noexcept :
+      soa_(&soa), idx_(static_cast<difference_type>(idx))
+  {
+  }
+
+  [[nodiscard]] constexpr reference operator*() const { return reference(*soa_, static_cast<size_type>(idx_)); }
+  [[nodiscard]] constexpr reference operator[](difference_type n) const
+  {
+    return reference(*soa_, static_cast<size_type>(idx_ + n));
+  }
+
+  constexpr iterator_impl& operator++() noexcept
+  {
+    ++idx_;
+    return *this;
+  }
+  constexpr iterator_impl operator++(int) noexcept
+  {
+    auto tmp = *this;
+    ++idx_;
+    return tmp;
+  }
+  constexpr iterator_impl& operator--() noexcept
+  {
+    --idx_;
+    return *this;
+  }
+  constexpr iterator_impl operator--(int) noexcept
+  {
+    auto tmp = *this;
+    --idx_;
+    return tmp;
+  }
+  constexpr iterator_impl& operator+=(difference_type n) noexcept
+  {
+    idx_ += n;
+    return *this;
+  }
+  constexpr iterator_impl& operator-=(difference_type n) noexcept
+  {
+    idx_ -= n;
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr iterator_impl operator+(iterator_impl it, difference_type n) noexcept
+  {
+    return it += n;
+  }
+  [[nodiscard]] friend constexpr iterator_impl operator+(difference_type n, iterator_impl it) noexcept
+  {
+    return it += n;
+  }
+  [[nodiscard]] friend constexpr iterator_impl operator-(iterator_impl it, difference_type n) noexcept
+  {
+    return it -= n;
+  }
+  [[nodiscard]] friend constexpr difference_type operator-(const iterator_impl& lhs, const iterator_impl& rhs) noexcept
+  {
+    return lhs.idx_ - rhs.idx_;
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const iterator_impl& lhs, const iterator_impl& rhs) noexcept
+  {
+    return lhs.idx_ == rhs.idx_;
+  }
+  [[nodiscard]] friend constexpr auto operator<=>(const iterator_impl& lhs, const iterator_impl& rhs) noexcept
+  {
+    return lhs.idx_ <=> rhs.idx_;
+  }
+};
+
+namespace detail {
+
+template<typename Func, auto R1, typename Rep1, std::size_t E1, auto R2, typename Rep2, std::size_t E2>
+[[nodiscard]] constexpr auto transform_columns(Func func, const quantity_span<R1, Rep1, E1>& lhs,
+                                               const quantity_span<R2, Rep2, E2>& rhs)
+{
+  gsl_Expects(lhs.size() == rhs.size());
+  using ret = decltype(func(std::declval<quantity<R1, std::remove_cv_t<Rep1>>>(),
+                            std::declval<quantity<R2, std::remove_cv_t<Rep2>>>()));
+  quantity_soa<ret> res(lhs.size());
+  const auto out = res.template column<0>();
+  for (std::size_t i = 0; i < lhs.size(); ++i) out[i] = func(lhs[i].get(), rhs[i].get());
+  return res;
+}
+
+}  // namespace detail
+
+// batch binary operators on columns
+//  Return an owning single-field `quantity_soa` of the result quantity type (a `quantity_span` would have no storage
+//  to refer to), whose `column<0>()` is the view of the result column.
+template<auto R1, typename Rep1, std::size_t E1, auto R2, typename Rep2, std::size_t E2>
+  requires requires(quantity<R1, std::remove_cv_t<Rep1>> lhs, quantity<R2, std::remove_cv_t<Rep2>> rhs) { lhs + rhs; }
+[[nodiscard]] constexpr auto operator+(const quantity_span<R1, Rep1, E1>& lhs, const quantity_span<R2, Rep2, E2>& rhs)
+{
+  return detail::transform_columns(std::plus<>{}, lhs, rhs);
+}
+
+template<auto R1, typename Rep1, std::size_t E1, auto R2, typename Rep2, std::size_t E2>
+  requires requires(quantity<R1, std::remove_cv_t<Rep1>> lhs, quantity<R2, std::remove_cv_t<Rep2>> rhs) { lhs - rhs; }
+[[nodiscard]] constexpr auto operator-(const quantity_span<R1, Rep1, E1>& lhs, const quantity_span<R2, Rep2, E2>& rhs)
+{
+  return detail::transform_columns(std::minus<>{}, lhs, rhs);
+}
+
+template<auto R1, typename Rep1, std::size_t E1, auto R2, typename Rep2, std::size_t E2>
+  requires requires(quantity<R1, std::remove_cv_t<Rep1>> lhs, quantity<R2, std::remove_cv_t<Rep2>> rhs) { lhs * rhs; }
+[[nodiscard]] constexpr auto operator*(const quantity_span<R1, Rep1, E1>& lhs, const quantity_span<R2, Rep2, E2>& rhs)
+{
+  return detail::transform_columns(std::multiplies<>{}, lhs, rhs);
+}
+
+template<auto R1, typename Rep1, std::size_t E1, auto R2, typename Rep2, std::size_t E2>
+  requires requires(quantity<R1, std::remove_cv_t<Rep1>> lhs, quantity<R2, std::remove_cv_t<Rep2>> rhs) { lhs / rhs; }
+[[nodiscard]] constexpr auto operator/(const quantity_span<R1, Rep1, E1>& lhs, const quantity_span<R2, Rep2, E2>& rhs)
+{
+  return detail::transform_columns(std::divides<>{}, lhs, rhs);
+}
+
+}  // namespace mp_units
+
+// structured bindings support for rows
+template<bool Const, mp_units::Quantity... Qs>
+struct std::tuple_size<mp_units::quantity_soa_row<Const, Qs...>> : std::integral_constant<std::size_t, sizeof...(Qs)> {};
+
+template<std::size_t I, bool Const, mp_units::Quantity... Qs>
+struct std::tuple_element<I, mp_units::quantity_soa_row<Const, Qs...>> {
+  using type = decltype(std::declval<mp_units::quantity_soa_row<Const, Qs...>>().template get<I>());
+};
+
+// `quantity_soa_row` is a proxy reference to `std::tuple<Qs...>`
+template<bool Const, mp_units::Quantity... Qs, template<typename> typename TQual, template<typename> typename UQual>
+struct std::basic_common_reference<mp_units::quantity_soa_row<Const, Qs...>, std::tuple<Qs...>, TQual, UQual> {
+  using type = std::tuple<Qs...>;
+};
+
+template<bool Const, mp_units::Quantity... Qs, template<typename> typename TQual, template<typename> typename UQual>
+struct std::basic_common_reference<std::tuple<Qs...>, mp_units::quantity_soa_row<Const, Qs...>, TQual, UQual> {
+  using type = std::tuple<Qs...>;
+};
@@ -0,0 +1,582 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <mp-units/bits/quantity_concepts.h>
+#include <mp-units/bits/reference_concepts.h>
+#include <mp-units/bits/representation_concepts.h>
+#include <mp-units/bits/simd.h>
+#include <mp-units/bits/sudo_cast.h>
+#include <mp-units/bits/value_cast.h>
+#include <mp-units/quantity.h>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+namespace mp_units {
+
+template<Reference auto R, typename Rep>
+class quantity_ref;
+
+namespace detail {
+
+template<typename T>
+inline constexpr bool is_quantity_ref = false;
+
+template<auto R, typename Rep>
+inline constexpr bool is_quantity_ref<quantity_ref<R, Rep>> = true;
+
+}  // namespace detail
+
+/**
+ * @brief A reference to a quantity stored as a raw numerical value
+ *
+ * A proxy type returned by the `quantity_span` element access. It does not copy the numerical value but
+ * refers to an element of the underlying buffer, so reading from it yields a `quantity<R, Rep>` and assigning
+ * to it modifies the buffer in place.
+ *
+ * @tparam R a reference of the quantity providing all information about quantity properties
+ * @tparam Rep a type of the underlying numerical value (possibly `const`-qualified)
+ */
+template<Reference auto R, typename Rep>
+class quantity_ref {
+  Rep* ptr_;
+
+public:
+  // member types and values
+  static constexpr Reference auto reference = R;
+  using rep = std::remove_cv_t<Rep>;
+  using value_type = quantity<R, rep>;
+
+  constexpr explicit quantity_ref(Rep& v) noexcept : ptr_(&v) {}
+  quantity_ref(const quantity_ref&) = default;
+
+  // assignment modifies the referenced value (not the reference itself)
+  constexpr const quantity_ref& operator=(const quantity_ref& other) const
+    requires(!std::is_const_v<Rep>)
+  {
+    *ptr_ = *other.ptr_;
+    return *this;
+  }
+
+  constexpr const quantity_ref& operator=(const value_type& q) const
+    requires(!std::is_const_v<Rep>)
+  {
+    *ptr_ = q.numerical_value();
+    return *this;
+  }
+
+  // data access
+  [[nodiscard]] constexpr Rep& numerical_value() const noexcept { return *ptr_; }
+  [[nodiscard]] constexpr value_type get() const { return make_quantity<R>(*ptr_); }
+  [[nodiscard]] constexpr operator value_type() const { return get(); }
+
+  // compound assignment operators
+  constexpr const quantity_ref& operator+=(const value_type& q) const
+    requires(!std::is_const_v<Rep>) && requires(rep a, rep b) { a += b; }
+  {
+    *ptr_ += q.numerical_value();
+    return *this;
+  }
+
+  constexpr const quantity_ref& operator-=(const value_type& q) const
+    requires(!std::is_const_v<Rep>) && requires(rep a, rep b) { a -= b; }
+  {
+    *ptr_ -= q.numerical_value();
+    return *this;
+  }
+
+  template<typename Value>
+    requires(!std::is_const_v<Rep>) && (!Quantity<Value>) && requires(rep a, const Value b) { a *= b; }
+  constexpr const quantity_ref& operator*=(const Value& v) const
+  {
+    *ptr_ *= v;
+    return *this;
+  }
+
+  template<typename Value>
+    requires(!std::is_const_v<Rep>) && (!Quantity<Value>) && requires(rep a, const Value b) { a /= b; }
+  constexpr const quantity_ref& operator/=(const Value& v) const
+  {
+    gsl_ExpectsAudit(v != quantity_values<Value>::zero());
+    *ptr_ /= v;
+    return *this;
+  }
+
+  // binary operators forward to the referenced quantity
+  template<typename T>
+    requires(!detail::is_quantity_ref<T>) && requires(const value_type& lhs, const T& rhs) { lhs + rhs; }
+  [[nodiscard]] friend constexpr auto operator+(const quantity_ref& lhs, const T& rhs)
+  {
+    return lhs.get() + rhs;
+  }
+
+  template<typename T>
+    requires(!detail::is_quantity_ref<T>) && requires(const T& lhs, const value_type& rhs) { lhs + rhs; }
+  [[nodiscard]] friend constexpr auto operator+(const T& lhs, const quantity_ref& rhs)
+  {
+    return lhs + rhs.get();
+  }
+
+  template<typename T>
+    requires(!detail::is_quantity_ref<T>) && requires(const value_type& lhs, const T& rhs) { lhs - rhs; }
+  [[nodiscard]] friend constexpr auto operator-(const quantity_ref& lhs, const T& rhs)
+  {
+    return lhs.get() - rhs;
+  }
+
+  template<typename T>
+    requires(!detail::is_quantity_ref<T>) && requires(const T& lhs, const value_type& rhs) { lhs - rhs; }
+  [[nodiscard]] friend constexpr auto operator-(const T& lhs, const quantity_ref& rhs)
+  {
+    return lhs - rhs.get();
+  }
+
+  template<typename T>
+    requires(!detail::is_quantity_ref<T>) && requires(const value_type& lhs, const T& rhs) { lhs * rhs; }
+  [[nodiscard]] friend constexpr auto operator*(const quantity_ref& lhs, const T& rhs)
+  {
+    return lhs.get() * rhs;
+  }
+
+  template<typename T>
+    requires(!detail::is_quantity_ref<T>) && requires(const T& lhs, const value_type& rhs) { lhs * rhs; }
+  [[nodiscard]] friend constexpr auto operator*(const T& lhs, const quantity_ref& rhs)
+  {
+    return lhs * rhs.get();
+  }
+
+  template<typename T>
+    requires(!detail::is_quantity_ref<T>) && requires(const value_type& lhs, const T& rhs) { lhs / rhs; }
+  [[nodiscard]] friend constexpr auto operator/(const quantity_ref& lhs, const T& rhs)
+  {
+    return lhs.get() / rhs;
+  }
+
+  template<typename T>
+    requires(!detail::is_quantity_ref<T>) && requires(const T& lhs, const value_type& rhs) { lhs / rhs; }
+  [[nodiscard]] friend constexpr auto operator/(const T& lhs, const quantity_ref& rhs)
+  {
+    return lhs / rhs.get();
+  }
+
+  // comparison
+  [[nodiscard]] friend constexpr bool operator==(const quantity_ref& lhs, const quantity_ref& rhs)
+    requires std::equality_comparable<rep>
+  {
+    return *lhs.ptr_ == *rhs.ptr_;
+  }
+
+  [[nodiscard]] friend constexpr auto operator<=>(const quantity_ref& lhs, const quantity_ref& rhs)
+    requires std::three_way_comparable<rep>
+  {
+    return *lhs.ptr_ <=> *rhs.ptr_;
+  }
+
+  template<Quantity Q>
+    requires requires(const value_type& lhs, const Q& rhs) { lhs == rhs; }
+  [[nodiscard]] friend constexpr bool operator==(const quantity_ref& lhs, const Q& rhs)
+  {
+    return lhs.get() == rhs;
+  }
+
+  template<Quantity Q>
+    requires requires(const value_type& lhs, const Q& rhs) { lhs <=> rhs; }
+  [[nodiscard]] friend constexpr auto operator<=>(const quantity_ref& lhs, const Q& rhs)
+  {
+    return lhs.get() <=> rhs;
+  }
+
+  friend constexpr void swap(const quantity_ref& lhs, const quantity_ref& rhs) noexcept
+    requires(!std::is_const_v<Rep>)
+  {
+    std::ranges::swap(*lhs.ptr_, *rhs.ptr_);
+  }
+};
+
+/**
+ * @brief A random access iterator over numerical values that yields quantities
+ *
+ * @tparam R a reference of the quantity providing all information about quantity properties
+ * @tparam Rep a type of the underlying numerical value (possibly `const`-qualified)
+ */
+template<Reference auto R, typename Rep>
+class quantity_iterator {
+  Rep* ptr_ = nullptr;
+
+public:
+  using iterator_concept = std::random_access_iterator_tag;
+  using iterator_category = std::input_iterator_tag;
+  using value_type = quantity<R, std::remove_cv_t<Rep>>;
+  using difference_type = std::ptrdiff_t;
+  using reference = quantity_ref<R, Rep>;
+
+  quantity_iterator() = default;
+  constexpr explicit quantity_iterator(Rep* ptr) noexcept : ptr_(ptr) {}
+
+  template<typename OtherRep>
+    requires std::convertible_to<OtherRep*, Rep*>
+  constexpr quantity_iterator(const quantity_iterator<R, OtherRep>& other) noexcept : ptr_(other.base())
+  {
+  }
+
+  // a pointer to the underlying numerical value
+  [[nodiscard]] constexpr Rep* base() const noexcept { return ptr_; }
+
+  [[nodiscard]] constexpr reference operator*() const noexcept { return reference(*ptr_); }
+  [[nodiscard]] constexpr reference operator[](difference_type n) const noexcept { return reference(ptr_[n]); }
+
+  constexpr quantity_iterator& operator++() noexcept
+  {
+    ++ptr_;
+    return *this;
+  }
+  constexpr quantity_iterator operator++(int) noexcept { return quantity_iterator(ptr_++); }
+  constexpr quantity_iterator& operator--() noexcept
+  {
+    --ptr_;
+    return *this;
+  }
+  constexpr quantity_iterator operator--(int) noexcept { return quantity_iterator(ptr_--); }
+  constexpr quantity_iterator& operator+=(difference_type n) noexcept
+  {
+    ptr_ += n;
+    return *this;
+  }
+  constexpr quantity_iterator& operator-=(difference_type n) noexcept
+  {
+    ptr_ -= n;
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr quantity_iterator operator+(quantity_iterator it, difference_type n) noexcept
+  {
+    return it += n;
+  }
+  [[nodiscard]] friend constexpr quantity_iterator operator+(difference_type n, quantity_iterator it) noexcept
+  {
+    return it += n;
+  }
+  [[nodiscard]] friend constexpr quantity_iterator operator-(quantity_iterator it, difference_type n) noexcept
+  {
+    return it -= n;
+  }
+  [[nodiscard]] friend constexpr difference_type operator-(const quantity_iterator& lhs,
+                                                           const quantity_iterator& rhs) noexcept
+  {
+    return lhs.ptr_ - rhs.ptr_;
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const quantity_iterator& lhs, const quantity_iterator& rhs) = default;
+  [[nodiscard]] friend constexpr auto operator<=>(const quantity_iterator& lhs, const quantity_iterator& rhs) = default;
+
+  [[nodiscard]] friend constexpr value_type iter_move(const quantity_iterator& it) { return (*it).get(); }
+
+  friend constexpr void iter_swap(const quantity_iterator& lhs, const quantity_iterator& rhs) noexcept
+    requires(!std::is_const_v<Rep>)
+  {
+    std::ranges::swap(*lhs.ptr_, *rhs.ptr_);
+  }
+};
+
+/**
+ * @brief A non-owning view of a contiguous sequence of numerical values interpreted as quantities
+ *
+ * Allows to use existing buffers of raw numbers (i.e. `std::vector<double>` or memory mapped files) as
+ * ranges of `quantity<R, Rep>` without copying the data. The reference and the representation type are
+ * known at compile time so batch algorithms may operate on the underlying `Rep*` directly through
+ * `data()` or `numerical_values()`.
+ *
+ * @tparam R a reference of the quantity providing all information about quantity properties
+ * @tparam Rep a type of the underlying numerical value (`const`-qualified for a read-only view)
+ * @tparam Extent the number of elements in the sequence, or `std::dynamic_extent` if dynamic
+ */
+template<Reference auto R, typename Rep = double, std::size_t Extent = std::dynamic_extent>
+  requires RepresentationOf<std::remove_cv_t<Rep>, get_quantity_spec(R).character>
+class quantity_span {
+  std::span<Rep, Extent> values_;
+
+public:
+  // member types and values
+  static constexpr Reference auto reference = R;
+  static constexpr QuantitySpec auto quantity_spec = get_quantity_spec(reference);
+  static constexpr Dimension auto dimension = quantity_spec.dimension;
+  static constexpr Unit auto unit = get_unit(reference);
+  static constexpr std::size_t extent = Extent;
+  using rep = std::remove_cv_t<Rep>;
+  using element_type = Rep;
+  using value_type = quantity<R, rep>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = Rep*;
+  using element_reference = quantity_ref<R, Rep>;
+  using iterator = quantity_iterator<R, Rep>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  // construction, assignment, destruction
+  quantity_span() = default;
+  quantity_span(const quantity_span&) = default;
+
+  constexpr explicit(Extent != std::dynamic_extent) quantity_span(Rep* first, size_type count) :
+      values_(first, count)
+  {
+  }
+
+  constexpr explicit(Extent != std::dynamic_extent) quantity_span(Rep* first, Rep* last) : values_(first, last) {}
+
+  constexpr explicit quantity_span(std::span<Rep, Extent> values) noexcept : values_(values) {}
+
+  template<std::ranges::contiguous_range Range>
+    requires(!std::is_base_of_v<quantity_span, std::remove_cvref_t<Range>>) &&
+            std::constructible_from<std::span<Rep, Extent>, Range&&>
+  constexpr explicit quantity_span(Range&& r) : values_(std::forward<Range>(r))
+  {
+  }
+
+  template<typename OtherRep, std::size_t OtherExtent>
+    requires(Extent == std::dynamic_extent || OtherExtent == std::dynamic_extent || Extent == OtherExtent) &&
+            std::convertible_to<OtherRep (*)[], Rep (*)[]>
+  constexpr explicit(Extent != std::dynamic_extent && OtherExtent == std::dynamic_extent)
+    quantity_span(const quantity_span<R, OtherRep, OtherExtent>& other) noexcept :
+      values_(other.numerical_values())
+  {
+  }
+
+  quantity_span& operator=(const quantity_span&) = default;
+
+  // data access
+  [[nodiscard]] constexpr std::span<Rep, Extent> numerical_values() const noexcept { return values_; }
+  [[nodiscard]] constexpr pointer data() const noexcept { return values_.data(); }
+  [[nodiscard]] constexpr size_type size() const noexcept { return values_.size(); }
+  [[nodiscard]] constexpr size_type size_bytes() const noexcept { return values_.size_bytes(); }
+  [[nodiscard]] constexpr bool empty() const noexcept { return values_.empty(); }
+
+  [[nodiscard]] constexpr element_reference operator[](size_type idx) const
+  {
+    gsl_ExpectsAudit(idx < size());
+    return element_reference(values_[idx]);
+  }
+
+  [[nodiscard]] constexpr element_reference front() const
+  {
+    gsl_ExpectsAudit(!empty());
+    return element_reference(values_.front());
+  }
+
+  [[nodiscard]] constexpr element_reference back() const
+  {
+    gsl_ExpectsAudit(!empty());
+    return element_reference(values_.back());
+  }
+
+  // iterators
+  [[nodiscard]] constexpr iterator begin() const noexcept { return iterator(data()); }
+  [[nodiscard]] constexpr iterator end() const noexcept { return iterator(data() + size()); }
+  [[nodiscard]] constexpr reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+  [[nodiscard]] constexpr reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+  // subviews
+  template<std::size_t Count>
+  [[nodiscard]] constexpr quantity_span<R, Rep, Count> first() const
+  {
+    return quantity_span<R, Rep, Count>(values_.template first<Count>());
+  }
+
+  template<std::size_t Count>
+  [[nodiscard]] constexpr quantity_span<R, Rep, Count> last() const
+  {
+    return quantity_span<R, Rep, Count>(values_.template last<Count>());
+  }
+
+  [[nodiscard]] constexpr quantity_span<R, Rep> first(size_type count) const
+  {
+    return quantity_span<R, Rep>(values_.first(count));
+  }
+
+  [[nodiscard]] constexpr quantity_span<R, Rep> last(size_type count) const
+  {
+    return quantity_span<R, Rep>(values_.last(count));
+  }
+
+  [[nodiscard]] constexpr quantity_span<R, Rep> subspan(size_type offset,
+                                                         size_type count = std::dynamic_extent) const
+  {
+    return quantity_span<R, Rep>(values_.subspan(offset, count));
+  }
+};
+
+namespace detail {
+
+template<typename T>
+inline constexpr bool is_specialization_of_quantity_span = false;
+
+template<auto R, typename Rep, std::size_t Extent>
+inline constexpr bool is_specialization_of_quantity_span<quantity_span<R, Rep, Extent>> = true;
+
+}  // namespace detail
+
+/**
+ * @brief A concept matching all quantity spans in the library
+ */
+template<typename T>
+concept QuantitySpan = detail::is_specialization_of_quantity_span<std::remove_cv_t<T>>;
+
+/**
+ * @brief Creates a `quantity_span` over a contiguous range of numerical values
+ *
+ * std::vector<double> buffer = ...;
+ * auto distances = make_quantity_span<si::metre>(buffer);
+ *
+ * @tparam R a reference to use for the numerical values
+ */
+template<Reference auto R, std::ranges::contiguous_range Range>
+  requires std::ranges::sized_range<Range> &&
+           RepresentationOf<std::ranges::range_value_t<Range>, get_quantity_spec(R).character>
+[[nodiscard]] constexpr quantity_span<R, std::remove_reference_t<std::ranges::range_reference_t<Range>>>
+make_quantity_span(Range&& r)
+{
+  return quantity_span<R, std::remove_reference_t<std::ranges::range_reference_t<Range>>>(std::forward<Range>(r));
+}
+
+/**
+ * @brief Creates a `quantity_span` over a raw buffer of numerical values
+ *
+ * auto* samples = static_cast<const float*>(mapped_file_data);
+ * auto temperatures = make_quantity_span<si::kelvin>(samples, count);
+ *
+ * @tparam R a reference to use for the numerical values
+ */
+template<Reference auto R, typename Rep>
+  requires RepresentationOf<std::remove_cv_t<Rep>, get_quantity_spec(R).character>
+[[nodiscard]] constexpr quantity_span<R, Rep> make_quantity_span(Rep* first, std::size_t count)
+{
+  return quantity_span<R, Rep>(first, count);
+}
+
+namespace detail {
+
+/**
+ * @brief Converts `n` numerical values of `From` quantities to the numerical values of `To` quantities
+ *
+ * Gives the same results as `sudo_cast` applied to every element. `float` and `double` values are scaled by the
+ * fused conversion factor with the SIMD kernels selected at runtime. `in` and `out` may be the same buffer.
+ */
+template<Quantity To, Quantity From>
+constexpr void sudo_cast_n(const typename From::rep* in, std::size_t n, typename To::rep* out)
+{
+  using rep = typename From::rep;
+  constexpr Magnitude auto c_mag = get_canonical_unit(From::unit).mag / get_canonical_unit(To::unit).mag;
+  if constexpr (std::same_as<rep, typename To::rep> && (std::same_as<rep, float> || std::same_as<rep, double>) &&
+                !MP_UNITS_PRECISE_SCALING && From::unit != To::unit && c_mag != mag<1>) {
+    if (!std::is_constant_evaluated()) {
+      simd::multiply(in, n, fused_conversion_factor<c_mag, rep>, out);
+      return;
+    }
+  }
+  for (std::size_t i = 0; i < n; ++i) out[i] = sudo_cast<To>(make_quantity<From::reference>(in[i])).numerical_value();
+}
+
+}  // namespace detail
+
+/**
+ * @brief Explicit cast of a unit of all quantities in a range
+ *
+ * Works like `value_cast<ToU>(q)` applied to every quantity of the input range and writes the results to `out`.
+ * The conversion factor is computed once at compile time. Conversions from a `quantity_span` to an iterator of
+ * another `quantity_span` with `float` or `double` representation type are done with explicit SIMD kernels selected
+ * at runtime for the current CPU.
+ *
+ * std::vector<double> km_buf = ..., m_buf(km_buf.size());
+ * value_cast<si::metre>(make_quantity_span<si::kilo<si::metre>>(km_buf), make_quantity_span<si::metre>(m_buf).begin());
+ *
+ * @tparam ToU a unit to use for the target quantities
+ *
+ * @return an output iterator past the last written element
+ */
+template<Unit auto ToU, std::ranges::input_range Range, std::weakly_incrementable O>
+  requires Quantity<std::ranges::range_value_t<Range>> &&
+           (convertible(std::ranges::range_value_t<Range>::reference, ToU)) &&
+           std::indirectly_writable<O, quantity<detail::value_cast_reference<std::ranges::range_value_t<Range>, ToU>(),
+                                                typename std::ranges::range_value_t<Range>::rep>>
+constexpr O value_cast(Range&& r, O out)
+{
+  using from_type = std::ranges::range_value_t<Range>;
+  using to_type = quantity<detail::value_cast_reference<from_type, ToU>(), typename from_type::rep>;
+  if constexpr (QuantitySpan<std::remove_cvref_t<Range>> &&
+                std::same_as<O, quantity_iterator<to_type::reference, typename to_type::rep>>) {
+    detail::sudo_cast_n<to_type, from_type>(r.data(), r.size(), out.base());
+    return out + static_cast<std::ptrdiff_t>(r.size());
+  } else {
+    for (auto&& q : r) {
+      *out = detail::sudo_cast<to_type>(static_cast<from_type>(q));
+      ++out;
+    }
+    return out;
+  }
+}
+
+/**
+ * @brief Explicit in-place cast of a unit of all quantities in a `quantity_span`
+ *
+ * The numerical values in the underlying buffer are overwritten with the ones expressed in `ToU`.
+ *
+ * auto metres = value_cast<si::metre>(make_quantity_span<si::kilo<si::metre>>(buffer));
+ *
+ * @tparam ToU a unit to use for the target quantities
+ *
+ * @return a view of the same buffer with the new unit
+ */
+template<Unit auto ToU, auto R, typename Rep, std::size_t Extent>
+  requires(!std::is_const_v<Rep>) && (convertible(R, ToU))
+constexpr quantity_span<detail::value_cast_reference<quantity<R, Rep>, ToU>(), Rep, Extent> value_cast(
+  quantity_span<R, Rep, Extent> s)
+{
+  using to_type = quantity<detail::value_cast_reference<quantity<R, Rep>, ToU>(), Rep>;
+  detail::sudo_cast_n<to_type, quantity<R, Rep>>(s.data(), s.size(), s.data());
+  return quantity_span<to_type::reference, Rep, Extent>(s.numerical_values());
+}
+
+}  // namespace mp_units
+
+template<auto R, typename Rep, std::size_t Extent>
+inline constexpr bool std::ranges::enable_borrowed_range<mp_units::quantity_span<R, Rep, Extent>> = true;
+
+template<auto R, typename Rep, std::size_t Extent>
+inline constexpr bool std::ranges::enable_view<mp_units::quantity_span<R, Rep, Extent>> = true;
+
+// `quantity_ref` is a proxy reference to `quantity`
+template<auto R, typename Rep, mp_units::Quantity Q, template<typename> typename TQual,
+         template<typename> typename UQual>
+  requires requires { typename std::common_type_t<mp_units::quantity<R, std::remove_cv_t<Rep>>, Q>; }
+struct std::basic_common_reference<mp_units::quantity_ref<R, Rep>, Q, TQual, UQual> {
+  using type = std::common_type_t<mp_units::quantity<R, std::remove_cv_t<Rep>>, Q>;
+};
+
+template<mp_units::Quantity Q, auto R, typename Rep, template<typename> typename TQual,
+         template<typename> typename UQual>
+  requires requires { typename std::common_type_t<Q, mp_units::quantity<R, std::remove_cv_t<Rep>>>; }
+struct std::basic_common_reference<Q, mp_units::quantity_ref<R, Rep>, TQual, UQual> {
+  using type = std::common_type_t<Q, mp_units::quantity<R, std::remove_cv_t<Rep>>>;
+};
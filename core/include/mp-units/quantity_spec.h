@@ -615,7 +615,7 @@ template<auto Q>
 }
 
 template<QuantitySpec Q>
-[[nodiscard]] consteval int get_complexity(Q)
+[[nodiscard]] consteval int get_complexity_impl(Q)
 {
   if constexpr (detail::IntermediateDerivedQuantitySpec<Q>)
     return get_complexity(typename Q::_num_{}) + get_complexity(typename Q::_den_{});
@@ -625,6 +625,17 @@ template<QuantitySpec Q>
     return 1;
 }
 
+// The properties of a quantity specification needed by the conversion checks are computed only once per translation
+// unit and stored in variable templates, so that the checks of different pairs reuse them instead of recomputing.
+template<QuantitySpec Q>
+inline constexpr int complexity = get_complexity_impl(Q{});
+
+template<QuantitySpec Q>
+[[nodiscard]] consteval int get_complexity(Q)
+{
+  return complexity<Q>;
+}
+
 // dimension_one is always the last one
 // otherwise, sort by typename
 template<Dimension D1, Dimension D2>
@@ -712,11 +723,8 @@ explode_result(Q) -> explode_result<Q>;
 
 #endif
 
-template<int Complexity, IntermediateDerivedQuantitySpec Q>
-[[nodiscard]] consteval auto explode(Q q);
-
-template<int Complexity, NamedQuantitySpec Q>
-[[nodiscard]] consteval auto explode(Q q);
+template<int Complexity, QuantitySpec Q>
+[[nodiscard]] consteval auto explode(Q);
 
 template<int Complexity, QuantitySpec Q, typename Num, typename... Nums, typename Den, typename... Dens>
 [[nodiscard]] consteval auto explode(Q, type_list<Num, Nums...>, type_list<Den, Dens...>)
@@ -775,7 +783,7 @@ template<int Complexity, QuantitySpec Q>
 }
 
 template<int Complexity, IntermediateDerivedQuantitySpec Q>
-[[nodiscard]] consteval auto explode(Q q)
+[[nodiscard]] consteval auto explode_impl(Q q)
 {
   constexpr auto c = get_complexity(q);
   if constexpr (c > Complexity)
@@ -786,7 +794,7 @@ template<int Complexity, IntermediateDerivedQuantitySpec Q>
 }
 
 template<int Complexity, NamedQuantitySpec Q>
-[[nodiscard]] consteval auto explode(Q q)
+[[nodiscard]] consteval auto explode_impl(Q q)
 {
   constexpr auto c = get_complexity(q);
   if constexpr (c > Complexity && requires { Q::_equation_; }) {
@@ -796,6 +804,16 @@ template<int Complexity, NamedQuantitySpec Q>
     return explode_result{q};
 }
 
+// `Q` exploded to ingredients of at most `Complexity`
+template<int Complexity, QuantitySpec Q>
+inline constexpr auto exploded = explode_impl<Complexity>(Q{});
+
+template<int Complexity, QuantitySpec Q>
+[[nodiscard]] consteval auto explode(Q)
+{
+  return exploded<Complexity, Q>;
+}
+
 template<typename NumFrom, typename... NumsFrom, typename DenFrom, typename... DensFrom, typename NumTo,
          typename... NumsTo, typename DenTo, typename... DensTo>
 [[nodiscard]] consteval specs_convertible_result are_ingredients_convertible(type_list<NumFrom, NumsFrom...> num_from,
@@ -831,4 +831,65 @@ template<typename CharT = char, Unit U>
   return buffer;
 }
 
+namespace detail {
+
+// A fixed-capacity buffer for generating unit symbols at compile-time
+//  (`Capacity == 0` only counts the characters)
+template<typename CharT, std::size_t Capacity>
+struct unit_symbol_buffer {
+  CharT data[Capacity + 1] = {};
+  std::size_t size = 0;
+
+  class iterator {
+    unit_symbol_buffer* buf_ = nullptr;
+
+  public:
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+    constexpr explicit iterator(unit_symbol_buffer& buf) : buf_(&buf) {}
+    constexpr iterator& operator=(CharT c)
+    {
+      if (buf_->size < Capacity) buf_->data[buf_->size] = c;
+      ++buf_->size;
+      return *this;
+    }
+    constexpr iterator& operator*() { return *this; }
+    constexpr iterator& operator++() { return *this; }
+    constexpr iterator operator++(int) { return *this; }
+  };
+};
+
+template<typename CharT, unit_symbol_formatting Fmt, Unit U>
+[[nodiscard]] consteval std::size_t unit_symbol_length(U u)
+{
+  unit_symbol_buffer<CharT, 0> buffer;
+  unit_symbol_to<CharT>(typename unit_symbol_buffer<CharT, 0>::iterator(buffer), u, Fmt);
+  return buffer.size;
+}
+
+template<typename CharT, unit_symbol_formatting Fmt, std::size_t N, Unit U>
+[[nodiscard]] consteval basic_fixed_string<CharT, N> make_unit_symbol(U u)
+{
+  unit_symbol_buffer<CharT, N> buffer;
+  unit_symbol_to<CharT>(typename unit_symbol_buffer<CharT, N>::iterator(buffer), u, Fmt);
+  return basic_fixed_string<CharT, N>(buffer.data);
+}
+
+}  // namespace detail
+
+/**
+ * @brief A unit symbol generated at compile-time
+ *
+ * Contrary to `unit_symbol_to()` that walks the unit expression on every call, the symbol is materialized
+ * only once as a `basic_fixed_string` with static storage duration, so printing it is a plain copy.
+ *
+ * @tparam U unit
+ * @tparam Fmt unit symbol formatting options
+ * @tparam CharT character type of the symbol
+ */
+template<Unit auto U, unit_symbol_formatting Fmt = unit_symbol_formatting{}, typename CharT = char>
+inline constexpr auto unit_symbol_v =
+  detail::make_unit_symbol<CharT, Fmt, detail::unit_symbol_length<CharT, Fmt>(U)>(U);
+
 }  // namespace mp_units
@@ -0,0 +1,239 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/external/hacks.h>
+#include <mp-units/quantity.h>
+#include <mp-units/systems/si/runtime_unit.h>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace mp_units::si {
+
+/**
+ * @brief A compact descriptor of a unit known only at runtime
+ *
+ * Holds the exponents of the ISQ base dimensions (length, mass, time, electric current, thermodynamic temperature,
+ * amount of substance, luminous intensity) as 8-bit fields packed into one 64-bit word and the magnitude of the unit
+ * relative to the coherent SI unit of the same dimension. Checking if two units have the same dimension is a single
+ * integer comparison, and the products and quotients of units add or subtract all the exponents at once.
+ */
+class dynamic_unit {
+  static constexpr std::uint64_t high_bits = 0x8080'8080'8080'8080;
+
+  std::uint64_t dimension_ = 0;
+  double magnitude_ = 1;
+
+  constexpr dynamic_unit(std::uint64_t dimension, double magnitude) : dimension_(dimension), magnitude_(magnitude) {}
+
+  // adds every byte separately (no carry between the exponents)
+  [[nodiscard]] static constexpr std::uint64_t add_exponents(std::uint64_t lhs, std::uint64_t rhs)
+  {
+    return ((lhs & ~high_bits) + (rhs & ~high_bits)) ^ ((lhs ^ rhs) & high_bits);
+  }
+
+  // subtracts every byte separately (no borrow between the exponents)
+  [[nodiscard]] static constexpr std::uint64_t subtract_exponents(std::uint64_t lhs, std::uint64_t rhs)
+  {
+    return ((lhs | high_bits) - (rhs & ~high_bits)) ^ ((lhs ^ ~rhs) & high_bits);
+  }
+
+public:
+  static constexpr std::size_t base_dimension_count = 7;
+
+  constexpr dynamic_unit() = default;
+
+  constexpr explicit dynamic_unit(const runtime_unit& u) : magnitude_(static_cast<double>(u.magnitude))
+  {
+    for (std::size_t i = 0; i < base_dimension_count; ++i)
+      dimension_ |= std::uint64_t{static_cast<std::uint8_t>(u.exponents[i])} << (8 * i);
+  }
+
+  template<Reference R>
+    requires(detail::is_si_expressible<get_unit(R{})>())
+  constexpr dynamic_unit(R) : dynamic_unit(detail::to_runtime_unit<get_unit(R{})>())
+  {
+  }
+
+  [[nodiscard]] constexpr std::uint64_t dimension() const noexcept { return dimension_; }
+  [[nodiscard]] constexpr double magnitude() const noexcept { return magnitude_; }
+
+  [[nodiscard]] constexpr int exponent(std::size_t base_dimension_index) const
+  {
+    gsl_Expects(base_dimension_index < base_dimension_count);
+    return static_cast<std::int8_t>(static_cast<std::uint8_t>(dimension_ >> (8 * base_dimension_index)));
+  }
+
+  [[nodiscard]] friend constexpr bool same_dimension(const dynamic_unit& lhs, const dynamic_unit& rhs) noexcept
+  {
+    return lhs.dimension_ == rhs.dimension_;
+  }
+
+  [[nodiscard]] friend constexpr dynamic_unit operator*(const dynamic_unit& lhs, const dynamic_unit& rhs)
+  {
+    return {add_exponents(lhs.dimension_, rhs.dimension_), lhs.magnitude_ * rhs.magnitude_};
+  }
+
+  [[nodiscard]] friend constexpr dynamic_unit operator/(const dynamic_unit& lhs, const dynamic_unit& rhs)
+  {
+    return {subtract_exponents(lhs.dimension_, rhs.dimension_), lhs.magnitude_ / rhs.magnitude_};
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const dynamic_unit&, const dynamic_unit&) = default;
+};
+
+/**
+ * @brief A quantity with a unit known only at runtime
+ *
+ * Stores the numerical value together with a `dynamic_unit`. Can be created from any `quantity` with a unit
+ * expressible in the SI base units or from a `runtime_unit` (i.e. parsed with `from_chars`), and converted back
+ * to a `quantity` after checking its dimension. The conversion factor of the target unit is computed at compile
+ * time so the conversion costs one integer comparison and two multiplications.
+ *
+ * @tparam Rep a floating-point type of the numerical value
+ */
+template<typename Rep = double>
+  requires treat_as_floating_point<Rep>
+class dynamic_quantity {
+  Rep value_{};
+  dynamic_unit unit_;
+
+public:
+  using rep = Rep;
+
+  dynamic_quantity() = default;
+
+  constexpr dynamic_quantity(const Rep& v, const dynamic_unit& u) : value_(v), unit_(u) {}
+
+  template<auto R, typename Rep2>
+    requires std::convertible_to<Rep2, Rep> && std::constructible_from<dynamic_unit, decltype(R)>
+  constexpr dynamic_quantity(const quantity<R, Rep2>& q) : value_(q.numerical_value()), unit_(R)
+  {
+  }
+
+  [[nodiscard]] constexpr const Rep& numerical_value() const noexcept { return value_; }
+  [[nodiscard]] constexpr const dynamic_unit& unit() const noexcept { return unit_; }
+
+  /**
+   * @brief Checks if the quantity can be converted to a quantity of the reference `R`
+   */
+  template<Reference auto R>
+    requires std::constructible_from<dynamic_unit, decltype(R)>
+  [[nodiscard]] constexpr bool convertible_to() const noexcept
+  {
+    constexpr dynamic_unit target(R);
+    return same_dimension(unit_, target);
+  }
+
+  /**
+   * @brief Converts the quantity to a quantity of the reference `R`
+   *
+   * @pre The quantity has the dimension of `R` (see `convertible_to()`)
+   */
+  template<Reference auto R, typename ToRep = Rep>
+    requires std::constructible_from<dynamic_unit, decltype(R)> && std::convertible_to<Rep, ToRep>
+  [[nodiscard]] constexpr quantity<R, ToRep> as() const
+  {
+    constexpr dynamic_unit target(R);
+    constexpr double inverse = 1 / target.magnitude();
+    gsl_Expects(same_dimension(unit_, target));
+    return make_quantity<R>(static_cast<ToRep>(value_ * static_cast<Rep>(unit_.magnitude() * inverse)));
+  }
+
+  template<auto R, typename ToRep>
+    requires requires(const dynamic_quantity& q) { q.template as<R, ToRep>(); }
+  [[nodiscard]] constexpr explicit operator quantity<R, ToRep>() const
+  {
+    return as<R, ToRep>();
+  }
+
+  /**
+   * @brief The numerical value of the quantity expressed in the coherent SI unit
+   */
+  [[nodiscard]] constexpr Rep coherent_value() const { return value_ * static_cast<Rep>(unit_.magnitude()); }
+
+  // arithmetic operators
+  [[nodiscard]] friend constexpr dynamic_quantity operator+(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+  {
+    gsl_Expects(same_dimension(lhs.unit_, rhs.unit_));
+    return {lhs.value_ + rhs.value_in(lhs.unit_), lhs.unit_};
+  }
+
+  [[nodiscard]] friend constexpr dynamic_quantity operator-(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+  {
+    gsl_Expects(same_dimension(lhs.unit_, rhs.unit_));
+    return {lhs.value_ - rhs.value_in(lhs.unit_), lhs.unit_};
+  }
+
+  [[nodiscard]] friend constexpr dynamic_quantity operator*(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+  {
+    return {lhs.value_ * rhs.value_, lhs.unit_ * rhs.unit_};
+  }
+
+  [[nodiscard]] friend constexpr dynamic_quantity operator/(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+  {
+    return {lhs.value_ / rhs.value_, lhs.unit_ / rhs.unit_};
+  }
+
+  [[nodiscard]] friend constexpr dynamic_quantity operator*(const dynamic_quantity& q, const Rep& v)
+  {
+    return {q.value_ * v, q.unit_};
+  }
+
+  [[nodiscard]] friend constexpr dynamic_quantity operator*(const Rep& v, const dynamic_quantity& q)
+  {
+    return {v * q.value_, q.unit_};
+  }
+
+  [[nodiscard]] friend constexpr dynamic_quantity operator/(const dynamic_quantity& q, const Rep& v)
+  {
+    return {q.value_ / v, q.unit_};
+  }
+
+  // comparison
+  [[nodiscard]] friend constexpr bool operator==(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+  {
+    gsl_Expects(same_dimension(lhs.unit_, rhs.unit_));
+    return lhs.value_ == rhs.value_in(lhs.unit_);
+  }
+
+  [[nodiscard]] friend constexpr auto operator<=>(const dynamic_quantity& lhs, const dynamic_quantity& rhs)
+  {
+    gsl_Expects(same_dimension(lhs.unit_, rhs.unit_));
+    return lhs.value_ <=> rhs.value_in(lhs.unit_);
+  }
+
+private:
+  // the numerical value in a unit of the same dimension
+  [[nodiscard]] constexpr Rep value_in(const dynamic_unit& u) const
+  {
+    return value_ * static_cast<Rep>(unit_.magnitude() / u.magnitude());
+  }
+};
+
+template<auto R, typename Rep>
+dynamic_quantity(quantity<R, Rep>) -> dynamic_quantity<Rep>;
+
+}  // namespace mp_units::si
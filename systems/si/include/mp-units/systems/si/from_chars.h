@@ -0,0 +1,494 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <mp-units/quantity.h>
+#include <mp-units/systems/si/runtime_unit.h>
+#include <mp-units/systems/si/unit_symbols.h>
+#include <mp-units/unit.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace mp_units {
+
+namespace detail {
+
+// FNV-1a of a symbol; the characters are hashed once per lookup and the result is mixed with the seeds
+[[nodiscard]] constexpr std::uint64_t symbol_hash(std::string_view str)
+{
+  std::uint64_t h = 14695981039346656037u;
+  for (char c : str) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 1099511628211u;
+  }
+  return h;
+}
+
+// the final avalanche of a symbol hash with a seed
+[[nodiscard]] constexpr std::uint32_t seeded_hash(std::uint64_t hash, std::uint32_t seed)
+{
+  hash ^= seed * 0x9E3779B97F4A7C15u;
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDu;
+  hash ^= hash >> 33;
+  return static_cast<std::uint32_t>(hash);
+}
+
+struct unit_symbol_entry {
+  std::string_view symbol;
+  si::runtime_unit unit;
+};
+
+/**
+ * @brief A compile-time built minimal perfect hash table of unit symbols
+ *
+ * Uses the hash-and-displace scheme: keys are first distributed into buckets, and for every bucket
+ * a seed is found that maps all of its keys to distinct free slots. There are exactly as many slots
+ * as keys, and a lookup is two hashes of the key and a single comparison of the symbols.
+ *
+ * @tparam Entry a type with a `symbol` member of `std::string_view` type
+ */
+template<typename Entry, std::size_t N>
+class unit_symbol_table {
+  static constexpr std::size_t bucket_count = std::bit_ceil(N / 2 + 1);
+  std::array<std::uint32_t, bucket_count> seeds_{};
+  std::array<Entry, N> slots_{};
+
+  // maps a hash to `[0, N)` without a division
+  [[nodiscard]] static constexpr std::size_t slot_of(std::uint32_t hash)
+  {
+    return static_cast<std::size_t>((std::uint64_t{hash} * N) >> 32);
+  }
+
+public:
+  consteval explicit unit_symbol_table(const std::array<Entry, N>& entries)
+  {
+    // group keys into buckets
+    std::array<std::size_t, N> keys{};
+    std::array<std::uint64_t, N> hashes{};
+    std::array<std::size_t, N> bucket_of{};
+    for (std::size_t i = 0; i < N; ++i) {
+      keys[i] = i;
+      hashes[i] = symbol_hash(entries[i].symbol);
+      bucket_of[i] = seeded_hash(hashes[i], 0) & (bucket_count - 1);
+    }
+    std::ranges::sort(keys, [&](std::size_t lhs, std::size_t rhs) { return bucket_of[lhs] < bucket_of[rhs]; });
+    std::array<std::size_t, bucket_count + 1> bucket_begin{};
+    for (std::size_t i = 0; i < N; ++i) ++bucket_begin[bucket_of[i] + 1];
+    for (std::size_t b = 0; b < bucket_count; ++b) bucket_begin[b + 1] += bucket_begin[b];
+
+    // process the largest buckets first
+    std::array<std::size_t, bucket_count> order{};
+    for (std::size_t b = 0; b < bucket_count; ++b) order[b] = b;
+    const auto size = [&](std::size_t b) { return bucket_begin[b + 1] - bucket_begin[b]; };
+    std::ranges::sort(order, [&](std::size_t lhs, std::size_t rhs) { return size(lhs) > size(rhs); });
+
+    std::array<bool, N> used{};
+    std::array<std::size_t, N> taken{};
+    for (std::size_t b : order) {
+      if (size(b) == 0) break;
+      for (std::uint32_t seed = 1;; ++seed) {
+        bool ok = true;
+        for (std::size_t k = 0; ok && k < size(b); ++k) {
+          const std::size_t slot = slot_of(seeded_hash(hashes[keys[bucket_begin[b] + k]], seed));
+          ok = !used[slot] && std::ranges::find(taken.begin(), taken.begin() + k, slot) == taken.begin() + k;
+          taken[k] = slot;
+        }
+        if (!ok) continue;
+        seeds_[b] = seed;
+        for (std::size_t k = 0; k < size(b); ++k) {
+          used[taken[k]] = true;
+          slots_[taken[k]] = entries[keys[bucket_begin[b] + k]];
+        }
+        break;
+      }
+    }
+  }
+
+  [[nodiscard]] static constexpr std::size_t size() { return N; }
+  [[nodiscard]] constexpr auto begin() const { return slots_.begin(); }
+  [[nodiscard]] constexpr auto end() const { return slots_.end(); }
+
+  [[nodiscard]] constexpr const Entry* find(std::string_view symbol) const
+  {
+    const std::uint64_t hash = symbol_hash(symbol);
+    const std::uint32_t seed = seeds_[seeded_hash(hash, 0) & (bucket_count - 1)];
+    const auto& entry = slots_[slot_of(seeded_hash(hash, seed))];
+    return !symbol.empty() && entry.symbol == symbol ? &entry : nullptr;
+  }
+};
+
+template<Unit auto U, text_encoding Encoding>
+[[nodiscard]] consteval std::string_view unit_symbol_view()
+{
+  constexpr auto& symbol = unit_symbol_v<U, unit_symbol_formatting{.encoding = Encoding}>;
+  return {symbol.data(), symbol.size()};
+}
+
+template<auto... Us>
+struct unit_list {
+  static constexpr std::size_t size = sizeof...(Us);
+};
+
+template<Unit auto... Us>
+[[nodiscard]] consteval auto make_unit_symbol_table(unit_list<Us...>)
+{
+  // both the Unicode and ASCII symbols of every unit (duplicates removed)
+  constexpr auto entries = [] {
+    std::array<unit_symbol_entry, 2 * sizeof...(Us)> all{
+      unit_symbol_entry{unit_symbol_view<Us, text_encoding::unicode>(), to_runtime_unit<Us>()}...,
+      unit_symbol_entry{unit_symbol_view<Us, text_encoding::ascii>(), to_runtime_unit<Us>()}...};
+    std::ranges::sort(all, {}, &unit_symbol_entry::symbol);
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < all.size(); ++i) {
+      if (count > 0 && all[count - 1].symbol == all[i].symbol) {
+        if (all[count - 1].unit != all[i].unit) throw std::invalid_argument("ambiguous unit symbol");
+        continue;
+      }
+      all[count++] = all[i];
+    }
+    return std::pair{all, count};
+  }();
+  std::array<unit_symbol_entry, entries.second> unique{};
+  std::ranges::copy_n(entries.first.begin(), entries.second, unique.begin());
+  return unit_symbol_table<unit_symbol_entry, entries.second>(unique);
+}
+
+namespace si_symbols {
+
+using namespace si::unit_symbols;
+
+// all the symbols from `mp-units/systems/si/unit_symbols.h` (except for the squared and cubic shortcuts)
+inline constexpr unit_list<
+  qm, rm, ym, zm, am, fm, pm, nm, um, mm, cm, dm, m, dam, hm, km, Mm, Gm, Tm, Pm, Em, Zm, Ym, Rm, Qm, qs, rs, ys, zs,
+  as, fs, ps, ns, us, ms, cs, ds, s, das, hs, ks, Ms, Gs, Ts, Ps, Es, Zs, Ys, Rs, Qs, qg, rg, yg, zg, ag, fg, pg, ng,
+  ug, mg, cg, dg, g, dag, hg, kg, Mg, Gg, Tg, Pg, Eg, Zg, Yg, Rg, Qg, qA, rA, yA, zA, aA, fA, pA, nA, uA, mA, cA, dA, A,
+  daA, hA, kA, MA, GA, TA, PA, EA, ZA, YA, RA, QA, qK, rK, yK, zK, aK, fK, pK, nK, uK, mK, cK, dK, K, daK, hK, kK, MK,
+  GK, TK, PK, EK, ZK, YK, RK, QK, qmol, rmol, ymol, zmol, amol, fmol, pmol, nmol, umol, mmol, cmol, dmol, mol, damol,
+  hmol, kmol, Mmol, Gmol, Tmol, Pmol, Emol, Zmol, Ymol, Rmol, Qmol, qcd, rcd, ycd, zcd, acd, fcd, pcd, ncd, ucd, mcd,
+  ccd, dcd, cd, dacd, hcd, kcd, Mcd, Gcd, Tcd, Pcd, Ecd, Zcd, Ycd, Rcd, Qcd, qrad, rrad, yrad, zrad, arad, frad, prad,
+  nrad, urad, mrad, crad, drad, rad, darad, hrad, krad, Mrad, Grad, Trad, Prad, Erad, Zrad, Yrad, Rrad, Qrad, qsr, rsr,
+  ysr, zsr, asr, fsr, psr, nsr, usr, msr, csr, dsr, sr, dasr, hsr, ksr, Msr, Gsr, Tsr, Psr, Esr, Zsr, Ysr, Rsr, Qsr,
+  qHz, rHz, yHz, zHz, aHz, fHz, pHz, nHz, uHz, mHz, cHz, dHz, Hz, daHz, hHz, kHz, MHz, GHz, THz, PHz, EHz, ZHz, YHz,
+  RHz, QHz, qN, rN, yN, zN, aN, fN, pN, nN, uN, mN, cN, dN, N, daN, hN, kN, MN, GN, TN, PN, EN, ZN, YN, RN, QN, qPa,
+  rPa, yPa, zPa, aPa, fPa, pPa, nPa, uPa, mPa, cPa, dPa, Pa, daPa, hPa, kPa, MPa, GPa, TPa, PPa, EPa, ZPa, YPa, RPa,
+  QPa, qJ, rJ, yJ, zJ, aJ, fJ, pJ, nJ, uJ, mJ, cJ, dJ, J, daJ, hJ, kJ, MJ, GJ, TJ, PJ, EJ, ZJ, YJ, RJ, QJ, qW, rW, yW,
+  zW, aW, fW, pW, nW, uW, mW, cW, dW, W, daW, hW, kW, MW, GW, TW, PW, EW, ZW, YW, RW, QW, qC, rC, yC, zC, aC, fC, pC,
+  nC, uC, mC, cC, dC, C, daC, hC, kC, MC, GC, TC, PC, EC, ZC, YC, RC, QC, qV, rV, yV, zV, aV, fV, pV, nV, uV, mV, cV,
+  dV, V, daV, hV, kV, MV, GV, TV, PV, EV, ZV, YV, RV, QV, qF, rF, yF, zF, aF, fF, pF, nF, uF, mF, cF, dF, F, daF, hF,
+  kF, MF, GF, TF, PF, EF, ZF, YF, RF, QF, qS, rS, yS, zS, aS, fS, pS, nS, uS, mS, cS, dS, S, daS, hS, kS, MS, GS, TS,
+  PS, ES, ZS, YS, RS, QS, qWb, rWb, yWb, zWb, aWb, fWb, pWb, nWb, uWb, mWb, cWb, dWb, Wb, daWb, hWb, kWb, MWb, GWb, TWb,
+  PWb, EWb, ZWb, YWb, RWb, QWb, qT, rT, yT, zT, aT, fT, pT, nT, uT, mT, cT, dT, T, daT, hT, kT, MT, GT, TT, PT, ET, ZT,
+  YT, RT, QT, qH, rH, yH, zH, aH, fH, pH, nH, uH, mH, cH, dH, H, daH, hH, kH, MH, GH, TH, PH, EH, ZH, YH, RH, QH, qlm,
+  rlm, ylm, zlm, alm, flm, plm, nlm, ulm, mlm, clm, dlm, lm, dalm, hlm, klm, Mlm, Glm, Tlm, Plm, Elm, Zlm, Ylm, Rlm,
+  Qlm, qlx, rlx, ylx, zlx, alx, flx, plx, nlx, ulx, mlx, clx, dlx, lx, dalx, hlx, klx, Mlx, Glx, Tlx, Plx, Elx, Zlx,
+  Ylx, Rlx, Qlx, qBq, rBq, yBq, zBq, aBq, fBq, pBq, nBq, uBq, mBq, cBq, dBq, Bq, daBq, hBq, kBq, MBq, GBq, TBq, PBq,
+  EBq, ZBq, YBq, RBq, QBq, qGy, rGy, yGy, zGy, aGy, fGy, pGy, nGy, uGy, mGy, cGy, dGy, Gy, daGy, hGy, kGy, MGy, GGy,
+  TGy, PGy, EGy, ZGy, YGy, RGy, QGy, qSv, rSv, ySv, zSv, aSv, fSv, pSv, nSv, uSv, mSv, cSv, dSv, Sv, daSv, hSv, kSv,
+  MSv, GSv, TSv, PSv, ESv, ZSv, YSv, RSv, QSv, qkat, rkat, ykat, zkat, akat, fkat, pkat, nkat, ukat, mkat, ckat, dkat,
+  kat, dakat, hkat, kkat, Mkat, Gkat, Tkat, Pkat, Ekat, Zkat, Ykat, Rkat, Qkat, deg_C, au, deg, arcmin, arcsec, a, ha,
+  l, t, Da, eV, min, h, d>
+  units;
+
+inline constexpr auto table = make_unit_symbol_table(units);
+
+}  // namespace si_symbols
+
+[[nodiscard]] constexpr bool is_unit_delimiter(const char* ptr, const char* last)
+{
+  const auto c = static_cast<unsigned char>(*ptr);
+  if (c < 0x80) return std::string_view(" \t\r\n/()^,;:=[]{}<>\"").find(static_cast<char>(c)) != std::string_view::npos;
+  // superscript digits and minus (¹²³ and U+2070-U+207B) or a half-high dot (U+22C5)
+  const std::string_view rest(ptr, static_cast<std::size_t>(last - ptr));
+  if (rest.size() >= 2 && c == 0xC2 && (rest[1] == '\xB9' || rest[1] == '\xB2' || rest[1] == '\xB3')) return true;
+  if (rest.size() >= 3 && c == 0xE2 && rest[1] == '\x81' && static_cast<unsigned char>(rest[2]) >= 0xB0 &&
+      static_cast<unsigned char>(rest[2]) <= 0xBB)
+    return true;
+  return rest.starts_with("⋅");
+}
+
+// Parses an optional exponent: `^n`, `^-n`, or Unicode superscripts
+// (`std::errc::result_out_of_range` is returned for the exponents outside of the range of `std::int8_t`)
+[[nodiscard]] inline std::from_chars_result parse_unit_exponent(const char* first, const char* last, int& exp)
+{
+  constexpr int min_exp = std::numeric_limits<std::int8_t>::min();
+  constexpr int max_exp = std::numeric_limits<std::int8_t>::max();
+  exp = 1;
+  if (first == last) return {first, std::errc{}};
+  if (*first == '^') {
+    const auto res = std::from_chars(first + 1, last, exp);
+    if (res.ec == std::errc{} && (exp < min_exp || exp > max_exp)) return {first, std::errc::result_out_of_range};
+    return res.ec == std::errc{} ? res : std::from_chars_result{first, res.ec};
+  }
+
+  constexpr std::string_view superscripts[] = {"⁰", "¹", "²", "³", "⁴", "⁵", "⁶", "⁷", "⁸", "⁹"};
+  const char* ptr = first;
+  bool negative = false;
+  if (std::string_view(ptr, static_cast<std::size_t>(last - ptr)).starts_with("⁻")) {
+    negative = true;
+    ptr += std::string_view("⁻").size();
+  }
+  int value = 0;
+  bool digits = false;
+  bool out_of_range = false;
+  for (bool found = true; found && ptr != last;) {
+    found = false;
+    for (int d = 0; d < 10; ++d) {
+      if (std::string_view(ptr, static_cast<std::size_t>(last - ptr)).starts_with(superscripts[d])) {
+        // saturated, so the long sequences of digits cannot overflow
+        value = value * 10 + d;
+        if (value > max_exp + 1) {
+          value = max_exp + 1;
+          out_of_range = true;
+        }
+        ptr += superscripts[d].size();
+        digits = found = true;
+        break;
+      }
+    }
+  }
+  if (!digits) return negative ? std::from_chars_result{first, std::errc::invalid_argument}
+                               : std::from_chars_result{first, std::errc{}};
+  exp = negative ? -value : value;
+  if (out_of_range || exp < min_exp || exp > max_exp) return {first, std::errc::result_out_of_range};
+  return {ptr, std::errc{}};
+}
+
+// `base` raised to `exp` by squaring (`std::pow` of `long double` is a slow library call even for small exponents)
+[[nodiscard]] constexpr long double int_power(long double base, int exp)
+{
+  if (exp < 0) return 1 / int_power(base, -exp);
+  long double res = 1;
+  for (; exp != 0; exp >>= 1, base *= base)
+    if (exp & 1) res *= base;
+  return res;
+}
+
+// Parses a single unit symbol from `table` with an optional exponent and accumulates it in `unit`
+// (`std::errc::result_out_of_range` is returned if the resulting exponents do not fit in `std::int8_t`)
+template<typename Table>
+[[nodiscard]] std::from_chars_result parse_unit_term(const Table& table, const char* first, const char* last,
+                                                     si::runtime_unit& unit, int sign)
+{
+  const char* ptr = first;
+  while (ptr != last && !is_unit_delimiter(ptr, last) && !(*ptr >= '0' && *ptr <= '9')) ++ptr;
+  const auto* entry = table.find(std::string_view(first, static_cast<std::size_t>(ptr - first)));
+  if (!entry) return {first, std::errc::invalid_argument};
+  const si::runtime_unit* found = &entry->unit;
+  int exp = 1;
+  const auto res = parse_unit_exponent(ptr, last, exp);
+  if (res.ec != std::errc{}) return {first, res.ec};
+  exp *= sign;
+  si::runtime_unit next = unit;
+  for (std::size_t i = 0; i < next.exponents.size(); ++i) {
+    const int e = unit.exponents[i] + exp * found->exponents[i];
+    if (!std::in_range<std::int8_t>(e)) return {first, std::errc::result_out_of_range};
+    next.exponents[i] = static_cast<std::int8_t>(e);
+  }
+  next.magnitude = unit.magnitude * int_power(found->magnitude, exp);
+  unit = next;
+  return res;
+}
+
+// Parses the terms separated with a space or a half-high dot
+template<typename Table>
+[[nodiscard]] std::from_chars_result parse_unit_product(const Table& table, const char* first, const char* last,
+                                                        si::runtime_unit& unit, int sign)
+{
+  auto res = parse_unit_term(table, first, last, unit, sign);
+  if (res.ec != std::errc{}) return res;
+  while (res.ptr != last) {
+    const std::string_view rest(res.ptr, static_cast<std::size_t>(last - res.ptr));
+    const std::size_t sep = rest.starts_with(' ') ? 1 : rest.starts_with("⋅") ? std::string_view("⋅").size() : 0;
+    if (sep == 0) break;
+    si::runtime_unit next = unit;
+    const auto term = parse_unit_term(table, res.ptr + sep, last, next, sign);
+    if (term.ec == std::errc::result_out_of_range) return term;
+    if (term.ec != std::errc{}) break;  // the separator does not belong to the unit
+    unit = next;
+    res.ptr = term.ptr;
+  }
+  return res;
+}
+
+// Parses a unit symbol expression with the symbols from `table`
+template<typename Table>
+[[nodiscard]] std::from_chars_result unit_from_chars(const Table& table, const char* first, const char* last,
+                                                     si::runtime_unit& unit)
+{
+  si::runtime_unit res;
+  const char* ptr = first;
+  if (ptr != last && *ptr == '1' && last - ptr > 1 && ptr[1] == '/')
+    ++ptr;  // "1/s"
+  else if (const auto num = parse_unit_product(table, ptr, last, res, 1); num.ec != std::errc{})
+    return {first, num.ec};
+  else
+    ptr = num.ptr;
+
+  if (ptr != last && *ptr == '/') {
+    ++ptr;
+    if (ptr != last && *ptr == '(') {
+      const auto den = parse_unit_product(table, ptr + 1, last, res, -1);
+      if (den.ec != std::errc{}) return {first, den.ec};
+      if (den.ptr == last || *den.ptr != ')') return {first, std::errc::invalid_argument};
+      ptr = den.ptr + 1;
+    } else if (const auto den = parse_unit_term(table, ptr, last, res, -1); den.ec != std::errc{})
+      return {first, den.ec};
+    else
+      ptr = den.ptr;
+  }
+  unit = res;
+  return {ptr, std::errc{}};
+}
+
+}  // namespace detail
+
+namespace si {
+
+/**
+ * @brief Parses a unit symbol expression
+ *
+ * Accepts the unit symbols from `mp-units/systems/si/unit_symbols.h` in both Unicode and ASCII
+ * encodings, combined the same way as they are printed (e.g. "km/h", "kg m⁻¹ s⁻²", "kg^1 m/(K mol s)").
+ * Parsing stops at the first character that is not a part of the unit. Nothing is allocated.
+ * `std::errc::result_out_of_range` is returned if an exponent of an SI base unit does not fit in `std::int8_t`.
+ */
+[[nodiscard]] inline std::from_chars_result unit_from_chars(const char* first, const char* last, runtime_unit& unit)
+{
+  return detail::unit_from_chars(detail::si_symbols::table, first, last, unit);
+}
+
+}  // namespace si
+
+namespace detail {
+
+// Parses the number and the optional unit following it (separated with at most one space)
+template<typename T>
+[[nodiscard]] std::from_chars_result quantity_from_chars(const char* first, const char* last, T& value,
+                                                         si::runtime_unit& unit)
+{
+  const auto num = std::from_chars(first, last, value);
+  if (num.ec != std::errc{}) return num;
+
+  const char* ptr = num.ptr;
+  if (ptr != last && *ptr == ' ') ++ptr;
+  if (ptr == last || is_unit_delimiter(ptr, last)) {
+    // no unit
+    unit = si::runtime_unit{};
+    return {num.ptr, std::errc{}};
+  }
+  const auto res = si::unit_from_chars(ptr, last, unit);
+  if (res.ec != std::errc{}) return {first, res.ec};
+  return res;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Parses a quantity with a unit known only at runtime
+ *
+ * @param first, last the range of characters to parse (e.g. "12.5 km/h")
+ * @param value the parsed number
+ * @param unit the parsed unit
+ */
+inline std::from_chars_result from_chars(const char* first, const char* last, double& value, si::runtime_unit& unit)
+{
+  return detail::quantity_from_chars(first, last, value, unit);
+}
+
+/**
+ * @brief Parses a quantity and converts it to the unit of `q` in the same pass
+ *
+ * The unit found in the text has to have the same dimension as the unit of `q`. Values of integral
+ * representation types are accepted only if the converted value is an integer (i.e. "3000 mm" or "1.5 km"
+ * into `quantity<si::metre, int>`, but not "1.5 m"); the number may then have a fractional part or an exponent.
+ * On failure `q` is not modified, and `std::errc::invalid_argument` or `std::errc::result_out_of_range`
+ * is returned.
+ */
+template<auto R, typename Rep>
+  requires(std::is_arithmetic_v<Rep> && detail::is_si_expressible<get_unit(R)>())
+std::from_chars_result from_chars(const char* first, const char* last, quantity<R, Rep>& q)
+{
+  constexpr si::runtime_unit target = detail::to_runtime_unit<get_unit(R)>();
+  si::runtime_unit unit;
+
+  // fast path for the symbol of the target unit
+  Rep value{};
+  const auto num = std::from_chars(first, last, value);
+  if (num.ec == std::errc{}) {
+    const char* ptr = num.ptr + (num.ptr != last && *num.ptr == ' ' ? 1 : 0);
+    const std::string_view rest(ptr, static_cast<std::size_t>(last - ptr));
+    constexpr auto symbol = detail::unit_symbol_view<get_unit(R), text_encoding::unicode>();
+    const auto is_end = [&](const char* p) {
+      // the unit may not continue with other terms
+      return p == last || (static_cast<unsigned char>(*p) < 0x80 && *p != ' ' && *p != '/' && *p != '^' &&
+                           detail::is_unit_delimiter(p, last));
+    };
+    if (!symbol.empty() && rest.starts_with(symbol) && is_end(ptr + symbol.size())) {
+      q = make_quantity<R>(value);
+      return {ptr + symbol.size(), std::errc{}};
+    }
+  } else if constexpr (std::is_floating_point_v<Rep>)
+    return num;
+
+  if constexpr (std::is_floating_point_v<Rep>) {
+    const auto res = detail::quantity_from_chars(first, last, value, unit);
+    if (res.ec != std::errc{}) return res;
+    if (unit.exponents != target.exponents) return {first, std::errc::invalid_argument};
+    if (const long double factor = unit.magnitude / target.magnitude; factor != 1) {
+      value = static_cast<Rep>(value * factor);
+      if (std::isinf(value)) return {first, std::errc::result_out_of_range};
+    }
+    q = make_quantity<R>(value);
+    return res;
+  } else {
+    // the number (which may also not be an integer or not fit `Rep`) is scaled in a wider floating-point type,
+    // and the result is accepted if it is an integer up to the rounding errors of the magnitudes
+    long double number{};
+    const auto res = detail::quantity_from_chars(first, last, number, unit);
+    if (res.ec != std::errc{}) return res;
+    if (unit.exponents != target.exponents) return {first, std::errc::invalid_argument};
+    const long double result = number * (unit.magnitude / target.magnitude);
+    const long double rounded = std::round(result);
+    if (std::abs(result - rounded) > std::abs(result) * 16 * std::numeric_limits<long double>::epsilon())
+      return {first, std::errc::invalid_argument};
+    // the bounds are powers of 2, so they are exact in any floating-point type
+    constexpr int digits = std::numeric_limits<Rep>::digits;
+    const long double lower = std::is_signed_v<Rep> ? -std::ldexp(1.0L, digits) : 0.0L;
+    if (rounded < lower || rounded >= std::ldexp(1.0L, digits)) return {first, std::errc::result_out_of_range};
+    q = make_quantity<R>(static_cast<Rep>(rounded));
+    return res;
+  }
+}
+
+}  // namespace mp_units
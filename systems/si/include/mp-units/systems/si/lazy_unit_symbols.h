@@ -0,0 +1,127 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/systems/si/prefixes.h>
+#include <mp-units/systems/si/units.h>
+
+namespace mp_units {
+
+namespace si::unit_symbols {
+
+// Prefixed symbols are created on demand (i.e. `k_<m>` or `u_<s>`) so that only the prefixed units actually used
+// get instantiated. Include `mp-units/systems/si/unit_symbols.h` to have all of them predefined with their usual
+// names (i.e. `km` or `us`).
+template<PrefixableUnit auto U> inline constexpr quecto_<U> q_;
+template<PrefixableUnit auto U> inline constexpr ronto_<U> r_;
+template<PrefixableUnit auto U> inline constexpr yocto_<U> y_;
+template<PrefixableUnit auto U> inline constexpr zepto_<U> z_;
+template<PrefixableUnit auto U> inline constexpr atto_<U> a_;
+template<PrefixableUnit auto U> inline constexpr femto_<U> f_;
+template<PrefixableUnit auto U> inline constexpr pico_<U> p_;
+template<PrefixableUnit auto U> inline constexpr nano_<U> n_;
+template<PrefixableUnit auto U> inline constexpr micro_<U> u_;
+template<PrefixableUnit auto U> inline constexpr milli_<U> m_;
+template<PrefixableUnit auto U> inline constexpr centi_<U> c_;
+template<PrefixableUnit auto U> inline constexpr deci_<U> d_;
+template<PrefixableUnit auto U> inline constexpr deca_<U> da_;
+template<PrefixableUnit auto U> inline constexpr hecto_<U> h_;
+template<PrefixableUnit auto U> inline constexpr kilo_<U> k_;
+template<PrefixableUnit auto U> inline constexpr mega_<U> M_;
+template<PrefixableUnit auto U> inline constexpr giga_<U> G_;
+template<PrefixableUnit auto U> inline constexpr tera_<U> T_;
+template<PrefixableUnit auto U> inline constexpr peta_<U> P_;
+template<PrefixableUnit auto U> inline constexpr exa_<U> E_;
+template<PrefixableUnit auto U> inline constexpr zetta_<U> Z_;
+template<PrefixableUnit auto U> inline constexpr yotta_<U> Y_;
+template<PrefixableUnit auto U> inline constexpr ronna_<U> R_;
+template<PrefixableUnit auto U> inline constexpr quetta_<U> Q_;
+
+inline constexpr auto m = metre;
+inline constexpr auto s = second;
+inline constexpr auto g = gram;
+inline constexpr auto kg = kilogram;
+inline constexpr auto A = ampere;
+inline constexpr auto K = kelvin;
+inline constexpr auto mol = mole;
+inline constexpr auto cd = candela;
+inline constexpr auto rad = radian;
+inline constexpr auto sr = steradian;
+inline constexpr auto Hz = hertz;
+inline constexpr auto N = newton;
+inline constexpr auto Pa = pascal;
+inline constexpr auto J = joule;
+inline constexpr auto W = watt;
+inline constexpr auto C = coulomb;
+inline constexpr auto V = volt;
+inline constexpr auto F = farad;
+inline constexpr auto S = siemens;
+inline constexpr auto Wb = weber;
+inline constexpr auto T = tesla;
+inline constexpr auto H = henry;
+inline constexpr auto lm = lumen;
+inline constexpr auto lx = lux;
+inline constexpr auto Bq = becquerel;
+inline constexpr auto Gy = gray;
+inline constexpr auto Sv = sievert;
+inline constexpr auto kat = katal;
+
+// no prefixes should be provided for the below units
+inline constexpr auto deg_C = degree_Celsius;
+
+// commonly used squared and cubic units
+inline constexpr auto m2 = square(metre);
+inline constexpr auto m3 = cubic(metre);
+inline constexpr auto m4 = pow<4>(metre);
+inline constexpr auto s2 = square(second);
+inline constexpr auto s3 = cubic(second);
+
+}  // namespace si::unit_symbols
+
+namespace non_si::unit_symbols {
+
+inline constexpr auto au = astronomical_unit;
+inline constexpr auto deg = degree;
+inline constexpr auto arcmin = arcminute;
+inline constexpr auto arcsec = arcsecond;
+inline constexpr auto a = are;
+inline constexpr auto ha = hectare;
+inline constexpr auto l = litre;
+inline constexpr auto t = tonne;
+inline constexpr auto Da = dalton;
+inline constexpr auto eV = electronvolt;
+
+// no prefixes should be provided for the below units
+inline constexpr auto min = minute;
+inline constexpr auto h = hour;
+inline constexpr auto d = day;
+
+}  // namespace non_si::unit_symbols
+
+namespace si::unit_symbols {
+
+using namespace non_si::unit_symbols;
+
+}  // namespace si::unit_symbols
+
+}  // namespace mp_units
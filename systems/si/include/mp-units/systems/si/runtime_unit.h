@@ -0,0 +1,159 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/magnitude.h>
+#include <mp-units/systems/si/units.h>
+#include <mp-units/unit.h>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+namespace mp_units {
+
+namespace si {
+
+/**
+ * @brief A unit known only at runtime
+ *
+ * Described by its magnitude relative to the coherent SI unit and the exponents of the SI base units
+ * in the order: metre, kilogram, second, ampere, kelvin, mole, candela.
+ */
+struct runtime_unit {
+  long double magnitude = 1;
+  std::array<std::int8_t, 7> exponents{};
+
+  [[nodiscard]] friend constexpr bool operator==(const runtime_unit&, const runtime_unit&) = default;
+};
+
+}  // namespace si
+
+namespace detail {
+
+template<typename T>
+[[nodiscard]] consteval int si_base_unit_index(T)
+{
+  if constexpr (is_same_v<T, struct si::metre>)
+    return 0;
+  else if constexpr (is_same_v<T, struct si::gram>)
+    return 1;
+  else if constexpr (is_same_v<T, struct si::second>)
+    return 2;
+  else if constexpr (is_same_v<T, struct si::ampere>)
+    return 3;
+  else if constexpr (is_same_v<T, struct si::kelvin>)
+    return 4;
+  else if constexpr (is_same_v<T, struct si::mole>)
+    return 5;
+  else if constexpr (is_same_v<T, struct si::candela>)
+    return 6;
+  else
+    return -1;
+}
+
+// Adds the exponents of a term of a canonical unit; returns `false` if it is not expressible in SI base units
+template<typename T>
+[[nodiscard]] consteval bool add_si_exponents(std::array<std::int8_t, 7>& exps, T, int sign)
+{
+  if constexpr (requires { typename T::factor; }) {
+    constexpr ratio r = T::exponent;
+    constexpr int idx = si_base_unit_index(typename T::factor{});
+    if constexpr (r.den != 1 || idx < 0)
+      return false;
+    else {
+      exps[idx] += static_cast<std::int8_t>(sign * r.num);
+      return true;
+    }
+  } else if constexpr (constexpr int idx = si_base_unit_index(T{}); idx >= 0) {
+    exps[idx] += static_cast<std::int8_t>(sign);
+    return true;
+  } else
+    return false;
+}
+
+template<typename... Nums, typename... Dens>
+[[nodiscard]] consteval bool add_si_exponents(std::array<std::int8_t, 7>& exps, type_list<Nums...>, type_list<Dens...>)
+{
+  return (true && ... && add_si_exponents(exps, Nums{}, 1)) && (true && ... && add_si_exponents(exps, Dens{}, -1));
+}
+
+template<Unit U>
+[[nodiscard]] consteval bool add_si_exponents(std::array<std::int8_t, 7>& exps, U u)
+{
+  if constexpr (requires { typename U::_num_; })
+    return add_si_exponents(exps, typename U::_num_{}, typename U::_den_{});
+  else
+    return add_si_exponents(exps, u, 1);
+}
+
+template<Unit auto U>
+[[nodiscard]] consteval bool is_si_expressible()
+{
+  std::array<std::int8_t, 7> exps{};
+  return add_si_exponents(exps, get_canonical_unit(U).reference_unit);
+}
+
+template<Unit auto U>
+  requires(is_si_expressible<U>())
+[[nodiscard]] consteval std::array<std::int8_t, 7> si_exponents()
+{
+  std::array<std::int8_t, 7> exps{};
+  (void)add_si_exponents(exps, get_canonical_unit(U).reference_unit);
+  return exps;
+}
+
+// Unlike `get_value<long double>()` tolerates rounding of the intermediate powers (e.g. 5⁻³⁵ of a dalton)
+template<auto Element>
+[[nodiscard]] consteval long double base_power_value()
+{
+  constexpr ratio exp = get_exponent(Element);
+  if constexpr (exp.den != 1)
+    throw std::invalid_argument("rational powers are not supported");
+  else {
+    const auto base = static_cast<long double>(get_base_value(Element));
+    long double res = 1;
+    for (std::intmax_t i = 0; i < (exp.num < 0 ? -exp.num : exp.num); ++i) res *= base;
+    return exp.num < 0 ? 1 / res : res;
+  }
+}
+
+template<auto... Ms>
+[[nodiscard]] consteval long double magnitude_value(magnitude<Ms...>)
+{
+  return (1.L * ... * base_power_value<Ms>());
+}
+
+template<Unit auto U>
+  requires(is_si_expressible<U>())
+[[nodiscard]] consteval si::runtime_unit to_runtime_unit()
+{
+  constexpr auto canonical = get_canonical_unit(U);
+  constexpr std::array<std::int8_t, 7> exponents = si_exponents<U>();
+  // the canonical units are expressed in grams while the coherent SI unit of mass is the kilogram
+  constexpr int mass = exponents[si_base_unit_index(si::gram)];
+  return {magnitude_value(canonical.mag * pow<-mass>(mag<1000>)), exponents};
+}
+
+}  // namespace detail
+
+}  // namespace mp_units
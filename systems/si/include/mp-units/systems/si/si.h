@@ -23,7 +23,7 @@
 #pragma once
 
 #include <mp-units/systems/si/constants.h>
+#include <mp-units/systems/si/lazy_unit_symbols.h>
 #include <mp-units/systems/si/point_origins.h>
 #include <mp-units/systems/si/prefixes.h>
-#include <mp-units/systems/si/unit_symbols.h>
 #include <mp-units/systems/si/units.h>
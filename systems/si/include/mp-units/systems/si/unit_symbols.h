@@ -22,12 +22,14 @@
 
 #pragma once
 
+#include <mp-units/systems/si/lazy_unit_symbols.h>
 #include <mp-units/systems/si/prefixes.h>
 #include <mp-units/systems/si/units.h>
 
-namespace mp_units {
+// Opt-in header predefining all the prefixed SI unit symbols. `mp-units/systems/si/si.h` provides only the unprefixed
+// ones together with the prefixes applied on demand (see `mp-units/systems/si/lazy_unit_symbols.h`).
 
-namespace si::unit_symbols {
+namespace mp_units::si::unit_symbols {
 
 inline constexpr auto qm = quecto<metre>;
 inline constexpr auto rm = ronto<metre>;
@@ -41,7 +43,6 @@ inline constexpr auto um = micro<metre>;
 inline constexpr auto mm = milli<metre>;
 inline constexpr auto cm = centi<metre>;
 inline constexpr auto dm = deci<metre>;
-inline constexpr auto m = metre;
 inline constexpr auto dam = deca<metre>;
 inline constexpr auto hm = hecto<metre>;
 inline constexpr auto km = kilo<metre>;
@@ -67,7 +68,6 @@ inline constexpr auto us = micro<second>;
 inline constexpr auto ms = milli<second>;
 inline constexpr auto cs = centi<second>;
 inline constexpr auto ds = deci<second>;
-inline constexpr auto s = second;
 // TODO Should the below multiples of second be provided?
 inline constexpr auto das = deca<second>;
 inline constexpr auto hs = hecto<second>;
@@ -94,10 +94,8 @@ inline constexpr auto ug = micro<gram>;
 inline constexpr auto mg = milli<gram>;
 inline constexpr auto cg = centi<gram>;
 inline constexpr auto dg = deci<gram>;
-inline constexpr auto g = gram;
 inline constexpr auto dag = deca<gram>;
 inline constexpr auto hg = hecto<gram>;
-inline constexpr auto kg = kilogram;
 inline constexpr auto Mg = mega<gram>;
 inline constexpr auto Gg = giga<gram>;
 inline constexpr auto Tg = tera<gram>;
@@ -120,7 +118,6 @@ inline constexpr auto uA = micro<ampere>;
 inline constexpr auto mA = milli<ampere>;
 inline constexpr auto cA = centi<ampere>;
 inline constexpr auto dA = deci<ampere>;
-inline constexpr auto A = ampere;
 inline constexpr auto daA = deca<ampere>;
 inline constexpr auto hA = hecto<ampere>;
 inline constexpr auto kA = kilo<ampere>;
@@ -146,7 +143,6 @@ inline constexpr auto uK = micro<kelvin>;
 inline constexpr auto mK = milli<kelvin>;
 inline constexpr auto cK = centi<kelvin>;
 inline constexpr auto dK = deci<kelvin>;
-inline constexpr auto K = kelvin;
 inline constexpr auto daK = deca<kelvin>;
 inline constexpr auto hK = hecto<kelvin>;
 inline constexpr auto kK = kilo<kelvin>;
@@ -172,7 +168,6 @@ inline constexpr auto umol = micro<mole>;
 inline constexpr auto mmol = milli<mole>;
 inline constexpr auto cmol = centi<mole>;
 inline constexpr auto dmol = deci<mole>;
-inline constexpr auto mol = mole;
 inline constexpr auto damol = deca<mole>;
 inline constexpr auto hmol = hecto<mole>;
 inline constexpr auto kmol = kilo<mole>;
@@ -198,7 +193,6 @@ inline constexpr auto ucd = micro<candela>;
 inline constexpr auto mcd = milli<candela>;
 inline constexpr auto ccd = centi<candela>;
 inline constexpr auto dcd = deci<candela>;
-inline constexpr auto cd = candela;
 inline constexpr auto dacd = deca<candela>;
 inline constexpr auto hcd = hecto<candela>;
 inline constexpr auto kcd = kilo<candela>;
@@ -224,7 +218,6 @@ inline constexpr auto urad = micro<radian>;
 inline constexpr auto mrad = milli<radian>;
 inline constexpr auto crad = centi<radian>;
 inline constexpr auto drad = deci<radian>;
-inline constexpr auto rad = radian;
 inline constexpr auto darad = deca<radian>;
 inline constexpr auto hrad = hecto<radian>;
 inline constexpr auto krad = kilo<radian>;
@@ -250,7 +243,6 @@ inline constexpr auto usr = micro<steradian>;
 inline constexpr auto msr = milli<steradian>;
 inline constexpr auto csr = centi<steradian>;
 inline constexpr auto dsr = deci<steradian>;
-inline constexpr auto sr = steradian;
 inline constexpr auto dasr = deca<steradian>;
 inline constexpr auto hsr = hecto<steradian>;
 inline constexpr auto ksr = kilo<steradian>;
@@ -276,7 +268,6 @@ inline constexpr auto uHz = micro<hertz>;
 inline constexpr auto mHz = milli<hertz>;
 inline constexpr auto cHz = centi<hertz>;
 inline constexpr auto dHz = deci<hertz>;
-inline constexpr auto Hz = hertz;
 inline constexpr auto daHz = deca<hertz>;
 inline constexpr auto hHz = hecto<hertz>;
 inline constexpr auto kHz = kilo<hertz>;
@@ -302,7 +293,6 @@ inline constexpr auto uN = micro<newton>;
 inline constexpr auto mN = milli<newton>;
 inline constexpr auto cN = centi<newton>;
 inline constexpr auto dN = deci<newton>;
-inline constexpr auto N = newton;
 inline constexpr auto daN = deca<newton>;
 inline constexpr auto hN = hecto<newton>;
 inline constexpr auto kN = kilo<newton>;
@@ -328,7 +318,6 @@ inline constexpr auto uPa = micro<pascal>;
 inline constexpr auto mPa = milli<pascal>;
 inline constexpr auto cPa = centi<pascal>;
 inline constexpr auto dPa = deci<pascal>;
-inline constexpr auto Pa = pascal;
 inline constexpr auto daPa = deca<pascal>;
 inline constexpr auto hPa = hecto<pascal>;
 inline constexpr auto kPa = kilo<pascal>;
@@ -354,7 +343,6 @@ inline constexpr auto uJ = micro<joule>;
 inline constexpr auto mJ = milli<joule>;
 inline constexpr auto cJ = centi<joule>;
 inline constexpr auto dJ = deci<joule>;
-inline constexpr auto J = joule;
 inline constexpr auto daJ = deca<joule>;
 inline constexpr auto hJ = hecto<joule>;
 inline constexpr auto kJ = kilo<joule>;
@@ -380,7 +368,6 @@ inline constexpr auto uW = micro<watt>;
 inline constexpr auto mW = milli<watt>;
 inline constexpr auto cW = centi<watt>;
 inline constexpr auto dW = deci<watt>;
-inline constexpr auto W = watt;
 inline constexpr auto daW = deca<watt>;
 inline constexpr auto hW = hecto<watt>;
 inline constexpr auto kW = kilo<watt>;
@@ -406,7 +393,6 @@ inline constexpr auto uC = micro<coulomb>;
 inline constexpr auto mC = milli<coulomb>;
 inline constexpr auto cC = centi<coulomb>;
 inline constexpr auto dC = deci<coulomb>;
-inline constexpr auto C = coulomb;
 inline constexpr auto daC = deca<coulomb>;
 inline constexpr auto hC = hecto<coulomb>;
 inline constexpr auto kC = kilo<coulomb>;
@@ -432,7 +418,6 @@ inline constexpr auto uV = micro<volt>;
 inline constexpr auto mV = milli<volt>;
 inline constexpr auto cV = centi<volt>;
 inline constexpr auto dV = deci<volt>;
-inline constexpr auto V = volt;
 inline constexpr auto daV = deca<volt>;
 inline constexpr auto hV = hecto<volt>;
 inline constexpr auto kV = kilo<volt>;
@@ -458,7 +443,6 @@ inline constexpr auto uF = micro<farad>;
 inline constexpr auto mF = milli<farad>;
 inline constexpr auto cF = centi<farad>;
 inline constexpr auto dF = deci<farad>;
-inline constexpr auto F = farad;
 inline constexpr auto daF = deca<farad>;
 inline constexpr auto hF = hecto<farad>;
 inline constexpr auto kF = kilo<farad>;
@@ -484,7 +468,6 @@ inline constexpr auto uS = micro<siemens>;
 inline constexpr auto mS = milli<siemens>;
 inline constexpr auto cS = centi<siemens>;
 inline constexpr auto dS = deci<siemens>;
-inline constexpr auto S = siemens;
 inline constexpr auto daS = deca<siemens>;
 inline constexpr auto hS = hecto<siemens>;
 inline constexpr auto kS = kilo<siemens>;
@@ -510,7 +493,6 @@ inline constexpr auto uWb = micro<weber>;
 inline constexpr auto mWb = milli<weber>;
 inline constexpr auto cWb = centi<weber>;
 inline constexpr auto dWb = deci<weber>;
-inline constexpr auto Wb = weber;
 inline constexpr auto daWb = deca<weber>;
 inline constexpr auto hWb = hecto<weber>;
 inline constexpr auto kWb = kilo<weber>;
@@ -536,7 +518,6 @@ inline constexpr auto uT = micro<tesla>;
 inline constexpr auto mT = milli<tesla>;
 inline constexpr auto cT = centi<tesla>;
 inline constexpr auto dT = deci<tesla>;
-inline constexpr auto T = tesla;
 inline constexpr auto daT = deca<tesla>;
 inline constexpr auto hT = hecto<tesla>;
 inline constexpr auto kT = kilo<tesla>;
@@ -562,7 +543,6 @@ inline constexpr auto uH = micro<henry>;
 inline constexpr auto mH = milli<henry>;
 inline constexpr auto cH = centi<henry>;
 inline constexpr auto dH = deci<henry>;
-inline constexpr auto H = henry;
 inline constexpr auto daH = deca<henry>;
 inline constexpr auto hH = hecto<henry>;
 inline constexpr auto kH = kilo<henry>;
@@ -588,7 +568,6 @@ inline constexpr auto ulm = micro<lumen>;
 inline constexpr auto mlm = milli<lumen>;
 inline constexpr auto clm = centi<lumen>;
 inline constexpr auto dlm = deci<lumen>;
-inline constexpr auto lm = lumen;
 inline constexpr auto dalm = deca<lumen>;
 inline constexpr auto hlm = hecto<lumen>;
 inline constexpr auto klm = kilo<lumen>;
@@ -614,7 +593,6 @@ inline constexpr auto ulx = micro<lux>;
 inline constexpr auto mlx = milli<lux>;
 inline constexpr auto clx = centi<lux>;
 inline constexpr auto dlx = deci<lux>;
-inline constexpr auto lx = lux;
 inline constexpr auto dalx = deca<lux>;
 inline constexpr auto hlx = hecto<lux>;
 inline constexpr auto klx = kilo<lux>;
@@ -640,7 +618,6 @@ inline constexpr auto uBq = micro<becquerel>;
 inline constexpr auto mBq = milli<becquerel>;
 inline constexpr auto cBq = centi<becquerel>;
 inline constexpr auto dBq = deci<becquerel>;
-inline constexpr auto Bq = becquerel;
 inline constexpr auto daBq = deca<becquerel>;
 inline constexpr auto hBq = hecto<becquerel>;
 inline constexpr auto kBq = kilo<becquerel>;
@@ -666,7 +643,6 @@ inline constexpr auto uGy = micro<gray>;
 inline constexpr auto mGy = milli<gray>;
 inline constexpr auto cGy = centi<gray>;
 inline constexpr auto dGy = deci<gray>;
-inline constexpr auto Gy = gray;
 inline constexpr auto daGy = deca<gray>;
 inline constexpr auto hGy = hecto<gray>;
 inline constexpr auto kGy = kilo<gray>;
@@ -692,7 +668,6 @@ inline constexpr auto uSv = micro<sievert>;
 inline constexpr auto mSv = milli<sievert>;
 inline constexpr auto cSv = centi<sievert>;
 inline constexpr auto dSv = deci<sievert>;
-inline constexpr auto Sv = sievert;
 inline constexpr auto daSv = deca<sievert>;
 inline constexpr auto hSv = hecto<sievert>;
 inline constexpr auto kSv = kilo<sievert>;
@@ -718,7 +693,6 @@ inline constexpr auto ukat = micro<katal>;
 inline constexpr auto mkat = milli<katal>;
 inline constexpr auto ckat = centi<katal>;
 inline constexpr auto dkat = deci<katal>;
-inline constexpr auto kat = katal;
 inline constexpr auto dakat = deca<katal>;
 inline constexpr auto hkat = hecto<katal>;
 inline constexpr auto kkat = kilo<katal>;
@@ -732,43 +706,4 @@ inline constexpr auto Ykat = yotta<katal>;
 inline constexpr auto Rkat = ronna<katal>;
 inline constexpr auto Qkat = quetta<katal>;
 
-// no prefixes should be provided for the below units
-inline constexpr auto deg_C = degree_Celsius;
-
-// commonly used squared and cubic units
-inline constexpr auto m2 = square(metre);
-inline constexpr auto m3 = cubic(metre);
-inline constexpr auto m4 = pow<4>(metre);
-inline constexpr auto s2 = square(second);
-inline constexpr auto s3 = cubic(second);
-
-}  // namespace si::unit_symbols
-
-namespace non_si::unit_symbols {
-
-// TODO Should the following non-SI units have prefixed symbols predefiend as well?
-inline constexpr auto au = astronomical_unit;
-inline constexpr auto deg = degree;
-inline constexpr auto arcmin = arcminute;
-inline constexpr auto arcsec = arcsecond;
-inline constexpr auto a = are;
-inline constexpr auto ha = hectare;
-inline constexpr auto l = litre;
-inline constexpr auto t = tonne;
-inline constexpr auto Da = dalton;
-inline constexpr auto eV = electronvolt;
-
-// no prefixes should be provided for the below units
-inline constexpr auto min = minute;
-inline constexpr auto h = hour;
-inline constexpr auto d = day;
-
-}  // namespace non_si::unit_symbols
-
-namespace si::unit_symbols {
-
-using namespace non_si::unit_symbols;
-
-}  // namespace si::unit_symbols
-
-}  // namespace mp_units
+}  // namespace mp_units::si::unit_symbols
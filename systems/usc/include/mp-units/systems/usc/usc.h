@@ -22,7 +22,9 @@
 
 #pragma once
 
+#include <mp-units/quantity_point.h>
 #include <mp-units/systems/international/international.h>
+#include <mp-units/systems/si/point_origins.h>
 #include <mp-units/unit.h>
 
 namespace mp_units::usc {
@@ -110,7 +112,8 @@ inline constexpr struct troy_pound : named_unit<"lb t", mag<12> * troy_once> {}
 inline constexpr struct inch_of_mercury : named_unit<"inHg", mag<ratio(3'386'389, 1'000)> * si::pascal> {} inch_of_mercury;
 
 // https://en.wikipedia.org/wiki/United_States_customary_units#Temperature
-inline constexpr struct degree_Fahrenheit : named_unit<basic_symbol_text{"°F", "`F"}, mag<ratio{9, 5}> * si::degree_Celsius> {} degree_Fahrenheit;
+inline constexpr struct degree_Fahrenheit : named_unit<basic_symbol_text{"°F", "`F"}, mag<ratio{5, 9}> * si::degree_Celsius> {} degree_Fahrenheit;
+inline constexpr struct zeroth_degree_Fahrenheit : relative_point_origin<si::ice_point - 32 * degree_Fahrenheit> {} zeroth_degree_Fahrenheit;
 // clang-format on
 
 namespace unit_symbols {
@@ -0,0 +1,420 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/external/hacks.h>
+#include <mp-units/bits/external/type_traits.h>
+#include <mp-units/bits/magnitude.h>
+#include <mp-units/bits/sudo_cast.h>
+#include <mp-units/customization_points.h>
+#include <bit>
+#include <climits>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace mp_units {
+
+namespace detail {
+
+// an integral type at least twice as wide as `T` (`void` if there is none)
+template<std::integral T>
+[[nodiscard]] consteval auto double_width_type()
+{
+  if constexpr (sizeof(T) <= sizeof(std::int32_t))
+    return std::type_identity<conditional<std::is_signed_v<T>, std::int64_t, std::uint64_t>>{};
+#if MP_UNITS_HAS_INT128
+  else if constexpr (sizeof(T) <= sizeof(std::int64_t)) {
+    __extension__ using type = conditional<std::is_signed_v<T>, __int128, unsigned __int128>;
+    return std::type_identity<type>{};
+  }
+#endif
+  else
+    return std::type_identity<void>{};
+}
+
+template<std::integral T>
+using double_width_t = MP_UNITS_TYPENAME decltype(double_width_type<T>())::type;
+
+// `x / 2^Shift` truncated towards zero (compilers do not always strength-reduce it for 128-bit integers)
+template<int Shift, typename T>
+[[nodiscard]] constexpr T shift_right_truncate(T x)
+{
+  if constexpr (T(-1) < T(0)) {
+    constexpr int sign_shift = static_cast<int>(sizeof(T) * CHAR_BIT) - 1;
+    return static_cast<T>((x + ((x >> sign_shift) & ((T{1} << Shift) - 1))) >> Shift);
+  } else
+    return x >> Shift;
+}
+
+}  // namespace detail
+
+/**
+ * @brief A binary fixed-point number
+ *
+ * Stores `value * 2^FractionalBits` in an integer of type `T`, so all the arithmetic is done in the integer
+ * units of the CPU. It is meant to be used as a representation type of quantities on platforms or code paths
+ * without floating-point support (i.e. `quantity<si::metre, fixed<std::int32_t, 16>>`).
+ *
+ * The conversions between units fold the scaling of a magnitude with the shift of the binary point into
+ * a single integral scaling at compile time (see `scaling_traits`).
+ *
+ * Multiplication and division are computed in a twice as wide integer and truncate the result towards zero.
+ * Like for the built-in integral types, overflow is not detected.
+ *
+ * @tparam T the integral type storing the scaled value
+ * @tparam FractionalBits the number of bits after the binary point
+ */
+template<std::integral T, int FractionalBits>
+  requires(!is_same_v<T, bool>) && (FractionalBits >= 0) && (FractionalBits < std::numeric_limits<T>::digits)
+class fixed {
+  T raw_{};
+
+  static constexpr T one_raw = T{1} << FractionalBits;
+
+  template<std::integral U, int F>
+    requires(!is_same_v<U, bool>) && (F >= 0) && (F < std::numeric_limits<U>::digits)
+  friend class fixed;
+
+  // changes the position of the binary point truncating towards zero
+  template<int From, int To, std::integral U>
+  [[nodiscard]] static constexpr T rescale(U raw)
+  {
+    if constexpr (To >= From)
+      return static_cast<T>(static_cast<T>(raw) * (T{1} << (To - From)));
+    else
+      return static_cast<T>(raw / (U{1} << (From - To)));
+  }
+
+public:
+  using underlying_type = T;
+  static constexpr int fractional_bits = FractionalBits;
+
+  fixed() = default;
+
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  constexpr fixed(U v) : raw_(rescale<0, FractionalBits>(v))
+  {
+  }
+
+  // rounds to the nearest representable value
+  template<std::floating_point U>
+  constexpr explicit fixed(U v) : raw_(static_cast<T>(v * one_raw + (v < 0 ? U(-0.5) : U(0.5))))
+  {
+  }
+
+  template<std::integral U, int F>
+  constexpr explicit(F > FractionalBits || !std::in_range<T>(std::numeric_limits<U>::max()) ||
+                     !std::in_range<T>(std::numeric_limits<U>::min()))
+    fixed(const fixed<U, F>& v) :
+      raw_(rescale<F, FractionalBits>(v.raw_))
+  {
+  }
+
+  [[nodiscard]] static constexpr fixed from_raw(T raw)
+  {
+    fixed res;
+    res.raw_ = raw;
+    return res;
+  }
+
+  [[nodiscard]] constexpr T raw() const { return raw_; }
+
+  template<std::floating_point U>
+  [[nodiscard]] constexpr explicit operator U() const
+  {
+    return static_cast<U>(raw_) / static_cast<U>(one_raw);
+  }
+
+  // truncates towards zero
+  template<std::integral U>
+  [[nodiscard]] constexpr explicit operator U() const
+  {
+    return static_cast<U>(raw_ / one_raw);
+  }
+
+  [[nodiscard]] constexpr fixed operator+() const { return *this; }
+  [[nodiscard]] constexpr fixed operator-() const { return from_raw(static_cast<T>(-raw_)); }
+
+  constexpr fixed& operator+=(const fixed& rhs)
+  {
+    raw_ = static_cast<T>(raw_ + rhs.raw_);
+    return *this;
+  }
+
+  constexpr fixed& operator-=(const fixed& rhs)
+  {
+    raw_ = static_cast<T>(raw_ - rhs.raw_);
+    return *this;
+  }
+
+  constexpr fixed& operator*=(const fixed& rhs)
+    requires(!is_same_v<detail::double_width_t<T>, void>)
+  {
+    using wide = detail::double_width_t<T>;
+    raw_ = static_cast<T>(detail::shift_right_truncate<FractionalBits>(static_cast<wide>(static_cast<wide>(raw_) * rhs.raw_)));
+    return *this;
+  }
+
+  constexpr fixed& operator/=(const fixed& rhs)
+    requires(!is_same_v<detail::double_width_t<T>, void>)
+  {
+    using wide = detail::double_width_t<T>;
+    raw_ = static_cast<T>(static_cast<wide>(raw_) * (wide{1} << FractionalBits) / rhs.raw_);
+    return *this;
+  }
+
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  constexpr fixed& operator*=(U rhs)
+  {
+    raw_ = static_cast<T>(raw_ * rhs);
+    return *this;
+  }
+
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  constexpr fixed& operator/=(U rhs)
+  {
+    raw_ = static_cast<T>(raw_ / rhs);
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr fixed operator+(fixed lhs, const fixed& rhs) { return lhs += rhs; }
+  [[nodiscard]] friend constexpr fixed operator-(fixed lhs, const fixed& rhs) { return lhs -= rhs; }
+
+  [[nodiscard]] friend constexpr fixed operator*(fixed lhs, const fixed& rhs)
+    requires requires { lhs *= rhs; }
+  {
+    return lhs *= rhs;
+  }
+
+  [[nodiscard]] friend constexpr fixed operator/(fixed lhs, const fixed& rhs)
+    requires requires { lhs /= rhs; }
+  {
+    return lhs /= rhs;
+  }
+
+  // the scaling by an integer does not need a wider type nor a shift
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  [[nodiscard]] friend constexpr fixed operator*(fixed lhs, U rhs)
+  {
+    return lhs *= rhs;
+  }
+
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  [[nodiscard]] friend constexpr fixed operator*(U lhs, fixed rhs)
+  {
+    return rhs *= lhs;
+  }
+
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  [[nodiscard]] friend constexpr fixed operator/(fixed lhs, U rhs)
+  {
+    return lhs /= rhs;
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const fixed&, const fixed&) = default;
+  [[nodiscard]] friend constexpr auto operator<=>(const fixed&, const fixed&) = default;
+};
+
+namespace detail {
+
+template<typename T>
+inline constexpr bool is_fixed = false;
+
+template<typename T, int F>
+inline constexpr bool is_fixed<fixed<T, F>> = true;
+
+// the integral types are the fixed-point numbers without a fractional part
+template<typename T>
+concept FixedPointLike = is_fixed<T> || (std::integral<T> && !is_same_v<T, bool>);
+
+template<FixedPointLike T>
+[[nodiscard]] constexpr auto fixed_raw(const T& v)
+{
+  if constexpr (is_fixed<T>)
+    return v.raw();
+  else
+    return v;
+}
+
+template<FixedPointLike T>
+inline constexpr int fixed_fractional_bits = 0;
+
+template<FixedPointLike T>
+  requires is_fixed<T>
+inline constexpr int fixed_fractional_bits<T> = T::fractional_bits;
+
+template<FixedPointLike T>
+[[nodiscard]] constexpr T fixed_from_raw(auto raw)
+{
+  if constexpr (is_fixed<T>)
+    return T::from_raw(static_cast<typename T::underlying_type>(raw));
+  else
+    return static_cast<T>(raw);
+}
+
+/**
+ * @brief A magnitude approximated by `multiplier / 2^shift` for the values of type `T`
+ *
+ * The shift is the largest one for which any value of `T` multiplied by the multiplier fits in a twice as wide type.
+ */
+template<Magnitude auto M, std::integral T>
+  requires(!is_same_v<double_width_t<T>, void>)
+struct fixed_multiplier {
+  using product_type = double_width_t<T>;
+
+private:
+  static constexpr int max_shift = std::numeric_limits<product_type>::digits - 1;
+  static constexpr int budget = std::numeric_limits<product_type>::digits - std::numeric_limits<T>::digits;
+
+  [[nodiscard]] static constexpr long double pow2(int exp)
+  {
+    long double res = 1;
+    for (int i = 0; i < exp; ++i) res *= 2;
+    return res;
+  }
+
+  static constexpr long double value = get_value<long double>(M);
+
+public:
+  // a multiplier rounded up may be larger by one than the scaled value
+  static constexpr bool encodable = value <= pow2(budget) - 1;
+  static constexpr int shift = [] {
+    int res = 0;
+    while (res < max_shift && value * pow2(res + 1) <= pow2(budget) - 1) ++res;
+    return res;
+  }();
+  // The multiplier of a rational magnitude is rounded up (as in T. Granlund, P. Montgomery, "Division by Invariant
+  // Integers using Multiplication"), so the error of the product is positive and smaller than the distance between
+  // two consecutive raw values. Thus, the truncation of the product does not lose the results that are exactly
+  // representable (i.e. `254 mm` is exactly `10 in`).
+  static constexpr product_type multiplier = [] {
+    const long double scaled = value * pow2(shift);
+    if constexpr (is_rational(M)) {
+      const auto res = static_cast<product_type>(scaled);
+      return static_cast<long double>(res) < scaled ? static_cast<product_type>(res + 1) : res;
+    } else
+      return static_cast<product_type>(scaled + 0.5L);
+  }();
+};
+
+// `true` if the raw value can be scaled exactly with a multiplication and a shift
+template<Magnitude auto M, std::integral T>
+[[nodiscard]] consteval bool exact_fixed_scaling()
+{
+  if constexpr (is_rational(M) && requires { scale_integral<M, T>(T{}); })
+    return std::has_single_bit(get_value<std::uintmax_t>(denominator(M)));
+  else
+    return false;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Scales fixed-point numbers in the conversions between units
+ *
+ * The magnitude of a conversion and the shift of the binary point of the representation types (i.e. from
+ * `fixed<std::int32_t, 16>` to `fixed<std::int32_t, 8>` or from `std::int64_t` to `fixed<std::int64_t, 32>`)
+ * are folded into a single magnitude at compile time, so the raw value is scaled only once:
+ * - by an exact integral scaling (a multiplication followed by a shift) if the denominator of the magnitude is
+ *   a power of two,
+ * - by a multiplication with a compile-time `multiplier / 2^shift` approximation of the magnitude otherwise
+ *   (i.e. for `km/h` to `m/s` or degrees to radians); the multiplier has at least 32 significant bits for
+ *   32-bit representations so the result may differ only by one in the last place from the exact one
+ *   (the exactly representable results of rational magnitudes are always exact).
+ *
+ * The result is truncated towards zero.
+ */
+template<detail::FixedPointLike From, detail::FixedPointLike To>
+  requires detail::is_fixed<From> || detail::is_fixed<To>
+struct scaling_traits<From, To> {
+  template<Magnitude auto M>
+  [[nodiscard]] static constexpr To scale(const From& v)
+  {
+    using from_raw = decltype(detail::fixed_raw(v));
+    constexpr Magnitude auto total =
+      M * pow<detail::fixed_fractional_bits<To> - detail::fixed_fractional_bits<From>>(mag<2>);
+    if constexpr (detail::exact_fixed_scaling<total, from_raw>())
+      return detail::fixed_from_raw<To>(detail::scale_integral<total, from_raw>(detail::fixed_raw(v)));
+    else if constexpr (requires { requires detail::fixed_multiplier<total, from_raw>::encodable; }) {
+      using multiplier = detail::fixed_multiplier<total, from_raw>;
+      using wide = MP_UNITS_TYPENAME multiplier::product_type;
+      return detail::fixed_from_raw<To>(detail::shift_right_truncate<multiplier::shift>(
+        static_cast<wide>(static_cast<wide>(detail::fixed_raw(v)) * multiplier::multiplier)));
+    } else if constexpr (is_rational(total) && requires { detail::scale_integral<total, from_raw>(from_raw{}); })
+      return detail::fixed_from_raw<To>(detail::scale_integral<total, from_raw>(detail::fixed_raw(v)));
+    else
+      return detail::fixed_from_raw<To>(static_cast<long double>(detail::fixed_raw(v)) *
+                                        get_value<long double>(total));
+  }
+};
+
+template<typename T, int F>
+inline constexpr bool is_scalar<fixed<T, F>> = true;
+
+template<typename T, int F>
+struct quantity_values<fixed<T, F>> {
+  static constexpr fixed<T, F> zero() noexcept { return fixed<T, F>{}; }
+  static constexpr fixed<T, F> one() noexcept { return fixed<T, F>(1); }
+  static constexpr fixed<T, F> min() noexcept { return fixed<T, F>::from_raw(std::numeric_limits<T>::lowest()); }
+  static constexpr fixed<T, F> max() noexcept { return fixed<T, F>::from_raw(std::numeric_limits<T>::max()); }
+};
+
+}  // namespace mp_units
+
+// the common types of `fixed` with the built-in types and other fixed-point numbers
+template<typename T, int F, std::integral U>
+  requires(!mp_units::is_same_v<U, bool>)
+struct std::common_type<mp_units::fixed<T, F>, U> {
+  using type = mp_units::fixed<T, F>;
+};
+
+template<typename T, int F, std::integral U>
+  requires(!mp_units::is_same_v<U, bool>)
+struct std::common_type<U, mp_units::fixed<T, F>> {
+  using type = mp_units::fixed<T, F>;
+};
+
+template<typename T, int F, std::floating_point U>
+struct std::common_type<mp_units::fixed<T, F>, U> {
+  using type = U;
+};
+
+template<typename T, int F, std::floating_point U>
+struct std::common_type<U, mp_units::fixed<T, F>> {
+  using type = U;
+};
+
+template<typename T1, int F1, typename T2, int F2>
+struct std::common_type<mp_units::fixed<T1, F1>, mp_units::fixed<T2, F2>> {
+  using type = mp_units::fixed<std::common_type_t<T1, T2>, (F1 > F2 ? F1 : F2)>;
+};
@@ -0,0 +1,366 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <gsl/gsl-lite.hpp>
+#include <mp-units/bits/external/hacks.h>
+#include <mp-units/bits/external/type_traits.h>
+#include <mp-units/bits/magnitude.h>
+#include <mp-units/bits/simd.h>
+#include <mp-units/bits/sudo_cast.h>
+#include <mp-units/customization_points.h>
+#include <mp-units/quantity_span.h>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined __STDCPP_FLOAT16_T__ || defined __STDCPP_BFLOAT16_T__
+#include <stdfloat>
+#endif
+
+namespace mp_units {
+
+namespace detail {
+
+// IEEE 754 binary16: 1 sign bit, 5 exponent bits, and 10 mantissa bits
+struct binary16_format {
+  static constexpr std::uint16_t max_bits = 0x7BFF;  // 65504
+  [[nodiscard]] static constexpr std::uint16_t from_float(float v) { return simd::float_to_binary16(v); }
+  [[nodiscard]] static constexpr float to_float(std::uint16_t bits) { return simd::binary16_to_float(bits); }
+  static void from_floats(const float* in, std::size_t n, std::uint16_t* out) { simd::narrow_binary16(in, n, out); }
+  static void to_floats(const std::uint16_t* in, std::size_t n, float* out) { simd::widen_binary16(in, n, out); }
+};
+
+// bfloat16: the upper half of IEEE 754 binary32 (1 sign bit, 8 exponent bits, and 7 mantissa bits)
+struct bfloat16_format {
+  static constexpr std::uint16_t max_bits = 0x7F7F;  // 3.3895e38
+  [[nodiscard]] static constexpr std::uint16_t from_float(float v) { return simd::float_to_bfloat16(v); }
+  [[nodiscard]] static constexpr float to_float(std::uint16_t bits) { return simd::bfloat16_to_float(bits); }
+  static void from_floats(const float* in, std::size_t n, std::uint16_t* out) { simd::narrow_bfloat16(in, n, out); }
+  static void to_floats(const std::uint16_t* in, std::size_t n, float* out) { simd::widen_bfloat16(in, n, out); }
+};
+
+}  // namespace detail
+
+/**
+ * @brief A 16-bit floating-point storage type
+ *
+ * Stores a value in half of the memory of a `float`, so it is meant to be used as a representation type of large
+ * columns of quantities that do not need more than 3 (`float16`) or 2 (`bfloat16`) significant decimal digits
+ * (i.e. `std::vector<quantity<si::metre, float16>>`). For compilers that provide `std::float16_t` and
+ * `std::bfloat16_t` those may be used as well.
+ *
+ * Every operation is computed in `float` and its result is rounded to the nearest representable value
+ * (ties to even). For longer computations it is better to convert the values to `float` first (see `widen()`).
+ *
+ * @tparam Format the bit layout of the value
+ */
+template<typename Format>
+class compact_float {
+  std::uint16_t bits_{};
+
+public:
+  using format = Format;
+
+  compact_float() = default;
+
+  constexpr explicit compact_float(float v) : bits_(Format::from_float(v)) {}
+
+  // `double` and `long double` values are rounded to `float` first
+  template<std::floating_point U>
+    requires(!is_same_v<U, float>)
+  constexpr explicit compact_float(U v) : compact_float(static_cast<float>(v))
+  {
+  }
+
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  constexpr compact_float(U v) : compact_float(static_cast<float>(v))
+  {
+  }
+
+  template<typename F>
+    requires(!is_same_v<F, Format>)
+  constexpr explicit compact_float(const compact_float<F>& v) : compact_float(static_cast<float>(v))
+  {
+  }
+
+  [[nodiscard]] static constexpr compact_float from_bits(std::uint16_t bits)
+  {
+    compact_float res;
+    res.bits_ = bits;
+    return res;
+  }
+
+  [[nodiscard]] constexpr std::uint16_t bits() const { return bits_; }
+
+  template<typename U>
+    requires std::is_arithmetic_v<U> && (!is_same_v<U, bool>)
+  [[nodiscard]] constexpr explicit operator U() const
+  {
+    return static_cast<U>(Format::to_float(bits_));
+  }
+
+  [[nodiscard]] constexpr compact_float operator+() const { return *this; }
+  [[nodiscard]] constexpr compact_float operator-() const
+  {
+    return from_bits(static_cast<std::uint16_t>(bits_ ^ 0x8000u));
+  }
+
+  constexpr compact_float& operator+=(const compact_float& rhs)
+  {
+    return *this = compact_float(static_cast<float>(*this) + static_cast<float>(rhs));
+  }
+
+  constexpr compact_float& operator-=(const compact_float& rhs)
+  {
+    return *this = compact_float(static_cast<float>(*this) - static_cast<float>(rhs));
+  }
+
+  constexpr compact_float& operator*=(const compact_float& rhs)
+  {
+    return *this = compact_float(static_cast<float>(*this) * static_cast<float>(rhs));
+  }
+
+  constexpr compact_float& operator/=(const compact_float& rhs)
+  {
+    return *this = compact_float(static_cast<float>(*this) / static_cast<float>(rhs));
+  }
+
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  constexpr compact_float& operator*=(U rhs)
+  {
+    return *this = compact_float(static_cast<float>(*this) * static_cast<float>(rhs));
+  }
+
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  constexpr compact_float& operator/=(U rhs)
+  {
+    return *this = compact_float(static_cast<float>(*this) / static_cast<float>(rhs));
+  }
+
+  [[nodiscard]] friend constexpr compact_float operator+(compact_float lhs, const compact_float& rhs)
+  {
+    return lhs += rhs;
+  }
+  [[nodiscard]] friend constexpr compact_float operator-(compact_float lhs, const compact_float& rhs)
+  {
+    return lhs -= rhs;
+  }
+  [[nodiscard]] friend constexpr compact_float operator*(compact_float lhs, const compact_float& rhs)
+  {
+    return lhs *= rhs;
+  }
+  [[nodiscard]] friend constexpr compact_float operator/(compact_float lhs, const compact_float& rhs)
+  {
+    return lhs /= rhs;
+  }
+
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  [[nodiscard]] friend constexpr compact_float operator*(compact_float lhs, U rhs)
+  {
+    return lhs *= rhs;
+  }
+
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  [[nodiscard]] friend constexpr compact_float operator*(U lhs, compact_float rhs)
+  {
+    return rhs *= lhs;
+  }
+
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  [[nodiscard]] friend constexpr compact_float operator/(compact_float lhs, U rhs)
+  {
+    return lhs /= rhs;
+  }
+
+  // compared like the `float` values (i.e. `-0 == +0` and NaNs are unordered)
+  [[nodiscard]] friend constexpr bool operator==(const compact_float& lhs, const compact_float& rhs)
+  {
+    return static_cast<float>(lhs) == static_cast<float>(rhs);
+  }
+
+  [[nodiscard]] friend constexpr std::partial_ordering operator<=>(const compact_float& lhs, const compact_float& rhs)
+  {
+    return static_cast<float>(lhs) <=> static_cast<float>(rhs);
+  }
+};
+
+using float16 = compact_float<detail::binary16_format>;
+using bfloat16 = compact_float<detail::bfloat16_format>;
+
+namespace detail {
+
+// the bit layout of the 16-bit floating-point types (`void` for the other types)
+template<typename T>
+struct float16_format {
+  using type = void;
+};
+
+template<typename Format>
+struct float16_format<compact_float<Format>> {
+  using type = Format;
+};
+
+#ifdef __STDCPP_FLOAT16_T__
+template<>
+struct float16_format<std::float16_t> {
+  using type = binary16_format;
+};
+#endif
+
+#ifdef __STDCPP_BFLOAT16_T__
+template<>
+struct float16_format<std::bfloat16_t> {
+  using type = bfloat16_format;
+};
+#endif
+
+template<typename T>
+concept Float16 = (!is_same_v<typename float16_format<T>::type, void>) && (sizeof(T) == sizeof(std::uint16_t));
+
+// the type in which the values of `T` are scaled (at least `float`)
+template<typename T>
+using float16_scaling_t = conditional<std::floating_point<T> && !Float16<T>, T, float>;
+
+}  // namespace detail
+
+/**
+ * @brief Scales the 16-bit floating-point numbers in the conversions between units
+ *
+ * The value is converted to `float` (or to a wider floating-point representation type taking part in the
+ * conversion), multiplied by the conversion factor in that precision, and rounded to the destination type once.
+ * This avoids rounding the conversion factor itself to 16 bits which would add up to 0.05% of error for `float16`
+ * and up to 0.4% for `bfloat16`.
+ */
+template<typename From, typename To>
+  requires(detail::Float16<From> || detail::Float16<To>) &&
+          (detail::Float16<From> || (std::is_arithmetic_v<From> && !is_same_v<From, bool>)) &&
+          (detail::Float16<To> || (std::is_arithmetic_v<To> && !is_same_v<To, bool>))
+struct scaling_traits<From, To> {
+  template<Magnitude auto M>
+  [[nodiscard]] static constexpr To scale(const From& v)
+  {
+    using compute = std::common_type_t<detail::float16_scaling_t<From>, detail::float16_scaling_t<To>>;
+    return static_cast<To>(static_cast<compute>(v) * detail::fused_conversion_factor<M, compute>);
+  }
+};
+
+/**
+ * @brief Rounds a span of `float` quantities to a span of 16-bit floating-point quantities
+ *
+ * Uses the AVX-512F or F16C conversion instructions for `float16` and the AVX-512-BF16 ones (or their AVX2
+ * emulation) for `bfloat16` if the CPU has them. The results do not depend on the selected kernel.
+ *
+ * @param in the quantities to convert
+ * @param out the quantities to overwrite with the results (of the same size as `in`)
+ */
+template<QuantitySpan In, QuantitySpan Out>
+  requires(In::reference == Out::reference) && is_same_v<typename In::rep, float> &&
+          detail::Float16<typename Out::rep> && (!std::is_const_v<typename Out::element_type>)
+void narrow(In in, Out out)
+{
+  using format = MP_UNITS_TYPENAME detail::float16_format<typename Out::rep>::type;
+  static_assert(sizeof(typename In::element_type) == sizeof(float));
+  static_assert(sizeof(typename Out::element_type) == sizeof(std::uint16_t));
+  gsl_Expects(in.size() == out.size());
+  format::from_floats(reinterpret_cast<const float*>(in.data()), in.size(),
+                      reinterpret_cast<std::uint16_t*>(out.data()));
+}
+
+/**
+ * @brief Converts a span of 16-bit floating-point quantities to a span of `float` quantities
+ *
+ * The conversion is exact (see `narrow()` for the instructions used).
+ *
+ * @param in the quantities to convert
+ * @param out the quantities to overwrite with the results (of the same size as `in`)
+ */
+template<QuantitySpan In, QuantitySpan Out>
+  requires(In::reference == Out::reference) && detail::Float16<typename In::rep> &&
+          is_same_v<typename Out::rep, float> && (!std::is_const_v<typename Out::element_type>)
+void widen(In in, Out out)
+{
+  using format = MP_UNITS_TYPENAME detail::float16_format<typename In::rep>::type;
+  static_assert(sizeof(typename In::element_type) == sizeof(std::uint16_t));
+  static_assert(sizeof(typename Out::element_type) == sizeof(float));
+  gsl_Expects(in.size() == out.size());
+  format::to_floats(reinterpret_cast<const std::uint16_t*>(in.data()), in.size(),
+                    reinterpret_cast<float*>(out.data()));
+}
+
+template<typename Format>
+inline constexpr bool treat_as_floating_point<compact_float<Format>> = true;
+
+template<typename Format>
+inline constexpr bool is_scalar<compact_float<Format>> = true;
+
+template<typename Format>
+struct quantity_values<compact_float<Format>> {
+  static constexpr compact_float<Format> zero() noexcept { return compact_float<Format>{}; }
+  static constexpr compact_float<Format> one() noexcept { return compact_float<Format>(1.0f); }
+  static constexpr compact_float<Format> min() noexcept
+  {
+    return compact_float<Format>::from_bits(static_cast<std::uint16_t>(Format::max_bits | 0x8000u));
+  }
+  static constexpr compact_float<Format> max() noexcept { return compact_float<Format>::from_bits(Format::max_bits); }
+};
+
+}  // namespace mp_units
+
+// the common types of the 16-bit floating-point storage types with the built-in types and with each other
+template<typename Format, std::integral U>
+  requires(!mp_units::is_same_v<U, bool>)
+struct std::common_type<mp_units::compact_float<Format>, U> {
+  using type = mp_units::compact_float<Format>;
+};
+
+template<typename Format, std::integral U>
+  requires(!mp_units::is_same_v<U, bool>)
+struct std::common_type<U, mp_units::compact_float<Format>> {
+  using type = mp_units::compact_float<Format>;
+};
+
+template<typename Format, std::floating_point U>
+struct std::common_type<mp_units::compact_float<Format>, U> {
+  using type = U;
+};
+
+template<typename Format, std::floating_point U>
+struct std::common_type<U, mp_units::compact_float<Format>> {
+  using type = U;
+};
+
+// `float16` and `bfloat16` values are both exactly representable as `float`
+template<typename Format1, typename Format2>
+  requires(!mp_units::is_same_v<Format1, Format2>)
+struct std::common_type<mp_units::compact_float<Format1>, mp_units::compact_float<Format2>> {
+  using type = float;
+};
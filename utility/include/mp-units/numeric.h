@@ -0,0 +1,254 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/bits/external/hacks.h>
+#include <mp-units/bits/simd.h>
+#include <mp-units/quantity.h>
+#include <mp-units/quantity_span.h>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+
+namespace mp_units {
+
+/**
+ * @brief The summation algorithm used by the reductions
+ *
+ * - `naive` - several independent accumulators (vectorized for `float` and `double`), the fastest one with the
+ *   error growing linearly with the number of elements,
+ * - `kahan` - Kahan's compensated summation,
+ * - `neumaier` - Neumaier's improvement of Kahan's summation that handles also the addends larger than the running
+ *   sum (vectorized for `float` and `double`),
+ * - `pairwise` - recursive halving of the range with the blocks of `pairwise_block_size` elements summed naively;
+ *   the error grows logarithmically with the number of elements.
+ *
+ * The compensated algorithms do not work if the compiler is allowed to reassociate floating-point operations
+ * (i.e. `-ffast-math`).
+ */
+enum class summation { naive, kahan, neumaier, pairwise };
+
+inline constexpr std::size_t pairwise_block_size = 128;
+
+namespace detail {
+
+template<typename R>
+concept QuantityRange =
+  std::ranges::random_access_range<R> && std::ranges::sized_range<R> && Quantity<std::ranges::range_value_t<R>>;
+
+// ranges exposing a contiguous storage of the numerical values (i.e. `quantity_span`)
+template<typename R>
+concept ContiguousNumericalValues = QuantityRange<R> && requires(R& r) {
+  {
+    r.numerical_values()
+  } -> std::ranges::contiguous_range;
+};
+
+template<typename T>
+concept SimdSummable = std::same_as<T, float> || std::same_as<T, double>;
+
+template<typename T>
+struct kahan_sum {
+  T sum{};
+  T compensation{};
+
+  constexpr void add(T x)
+  {
+    const T y = x - compensation;
+    const T t = sum + y;
+    compensation = (t - sum) - y;
+    sum = t;
+  }
+
+  constexpr void merge(const kahan_sum& other)
+  {
+    add(other.sum);
+    add(-other.compensation);
+  }
+
+  [[nodiscard]] constexpr T result() const { return sum - compensation; }
+};
+
+template<typename T>
+struct naive_sum {
+  T sum{};
+
+  constexpr void add(const T& x) { sum += x; }
+  constexpr void merge(const naive_sum& other) { sum += other.sum; }
+  [[nodiscard]] constexpr T result() const { return sum; }
+};
+
+template<summation Mode, typename T>
+using accumulator_for = std::conditional_t<Mode == summation::kahan, kahan_sum<T>,
+                                           std::conditional_t<Mode == summation::neumaier, simd::neumaier_sum<T>,
+                                                              naive_sum<T>>>;
+
+/**
+ * @brief Sums `get(i)` for `i` in `[first, last)`
+ *
+ * Uses 4 independent accumulators that the compiler may keep in the lanes of a vector register.
+ */
+template<summation Mode, typename T, typename Get>
+[[nodiscard]] constexpr T reduce_values(std::size_t first, std::size_t last, Get& get)
+{
+  if constexpr (Mode == summation::pairwise) {
+    if (last - first <= pairwise_block_size) return reduce_values<summation::naive, T>(first, last, get);
+    const std::size_t middle = first + (last - first) / 2;
+    return reduce_values<Mode, T>(first, middle, get) + reduce_values<Mode, T>(middle, last, get);
+  } else {
+    accumulator_for<Mode, T> acc[4]{};
+    // counted in blocks as in `simd::sum_scalar` (GCC 12 false positive `-Waggressive-loop-optimizations`)
+    const std::size_t end = last - (last - first) % 4;
+    std::size_t i = first;
+    for (; i != end; i += 4)
+      for (std::size_t k = 0; k < 4; ++k) acc[k].add(static_cast<T>(get(i + k)));
+    for (; i < last; ++i) acc[0].add(static_cast<T>(get(i)));
+    acc[0].merge(acc[1]);
+    acc[2].merge(acc[3]);
+    acc[0].merge(acc[2]);
+    return acc[0].result();
+  }
+}
+
+template<summation Mode, SimdSummable T>
+[[nodiscard]] T sum_simd(const T* in, std::size_t n)
+{
+  if constexpr (Mode == summation::naive)
+    return simd::sum(in, n);
+  else if constexpr (Mode == summation::neumaier)
+    return simd::sum_compensated(in, n).result();
+  else if constexpr (Mode == summation::pairwise) {
+    if (n <= pairwise_block_size) return simd::sum(in, n);
+    const std::size_t half = n / 2;
+    return sum_simd<Mode>(in, half) + sum_simd<Mode>(in + half, n - half);
+  } else {
+    auto get = [&](std::size_t i) { return in[i]; };
+    return reduce_values<Mode, T>(0, n, get);
+  }
+}
+
+template<QuantityRange R>
+[[nodiscard]] constexpr auto numerical_value_getter(R& r)
+{
+  if constexpr (ContiguousNumericalValues<R>)
+    return [data = std::ranges::data(r.numerical_values())](std::size_t i) { return data[i]; };
+  else
+    return [it = std::ranges::begin(r)](std::size_t i) {
+      return static_cast<std::ranges::range_value_t<R>>(it[static_cast<std::ranges::range_difference_t<R>>(i)])
+        .numerical_value();
+    };
+}
+
+}  // namespace detail
+
+/**
+ * @brief Computes the sum of all quantities in a range
+ *
+ * The numerical values are summed in the representation type of the range elements with the selected summation
+ * algorithm (for `float` and `double` stored contiguously, i.e. in a `quantity_span`, with the SIMD kernels selected
+ * at runtime for the current CPU).
+ *
+ * @tparam Mode summation algorithm
+ * @param r random access range of quantities
+ * @return Quantity The sum of the quantities (zero for an empty range)
+ */
+template<summation Mode = summation::neumaier, detail::QuantityRange R>
+[[nodiscard]] constexpr std::ranges::range_value_t<R> sum(R&& r)
+{
+  using Q = std::ranges::range_value_t<R>;
+  using rep = typename Q::rep;
+  const auto n = static_cast<std::size_t>(std::ranges::size(r));
+  if constexpr (detail::ContiguousNumericalValues<R> && detail::SimdSummable<rep>) {
+    if (!std::is_constant_evaluated())
+      return make_quantity<Q::reference>(detail::sum_simd<Mode>(std::ranges::data(r.numerical_values()), n));
+  }
+  auto get = detail::numerical_value_getter(r);
+  return make_quantity<Q::reference>(detail::reduce_values<Mode, rep>(0, n, get));
+}
+
+/**
+ * @brief Computes the arithmetic mean of all quantities in a range
+ *
+ * @tparam Mode summation algorithm
+ * @param r non-empty random access range of quantities
+ * @return Quantity The mean of the quantities
+ */
+template<summation Mode = summation::neumaier, detail::QuantityRange R>
+[[nodiscard]] constexpr std::ranges::range_value_t<R> mean(R&& r)
+{
+  using rep = typename std::ranges::range_value_t<R>::rep;
+  gsl_Expects(!std::ranges::empty(r));
+  return sum<Mode>(r) / static_cast<rep>(std::ranges::size(r));
+}
+
+/**
+ * @brief Computes the sum of the products of the corresponding quantities from two ranges
+ *
+ * The result is expressed in the product of the references of both ranges (i.e. `N * m` for ranges of forces and
+ * displacements).
+ *
+ * @tparam Mode summation algorithm of the products
+ * @param r1 random access range of quantities
+ * @param r2 random access range of quantities of the same size as `r1`
+ * @return Quantity The dot product of the ranges
+ */
+template<summation Mode = summation::neumaier, detail::QuantityRange R1, detail::QuantityRange R2>
+  requires requires(std::ranges::range_value_t<R1> q1, std::ranges::range_value_t<R2> q2) { q1* q2; }
+[[nodiscard]] constexpr Quantity auto dot(R1&& r1, R2&& r2)
+{
+  using ret = decltype(std::declval<std::ranges::range_value_t<R1>>() * std::declval<std::ranges::range_value_t<R2>>());
+  gsl_Expects(std::ranges::size(r1) == std::ranges::size(r2));
+  auto get = [get1 = detail::numerical_value_getter(r1), get2 = detail::numerical_value_getter(r2)](std::size_t i) {
+    return get1(i) * get2(i);
+  };
+  return make_quantity<ret::reference>(
+    detail::reduce_values<Mode, typename ret::rep>(0, static_cast<std::size_t>(std::ranges::size(r1)), get));
+}
+
+/**
+ * @brief Finds the smallest and the largest quantity in a range in a single pass
+ *
+ * @param r non-empty random access range of quantities
+ * @return std::ranges::min_max_result The smallest and the largest quantity
+ */
+template<detail::QuantityRange R>
+[[nodiscard]] constexpr std::ranges::min_max_result<std::ranges::range_value_t<R>> min_max(R&& r)
+{
+  using Q = std::ranges::range_value_t<R>;
+  gsl_Expects(!std::ranges::empty(r));
+  auto get = detail::numerical_value_getter(r);
+  const auto n = static_cast<std::size_t>(std::ranges::size(r));
+  auto min = get(0);
+  auto max = min;
+  for (std::size_t i = 1; i < n; ++i) {
+    const auto v = get(i);
+    min = v < min ? v : min;
+    max = max < v ? v : max;
+  }
+  return {make_quantity<Q::reference>(min), make_quantity<Q::reference>(max)};
+}
+
+}  // namespace mp_units
@@ -0,0 +1,493 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <gsl/gsl-lite.hpp>
+#include <mp-units/bits/external/hacks.h>
+#include <mp-units/bits/external/type_traits.h>
+#include <mp-units/bits/magnitude.h>
+#include <mp-units/bits/simd.h>
+#include <mp-units/bits/sudo_cast.h>
+#include <mp-units/customization_points.h>
+#include <mp-units/quantity_span.h>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace mp_units {
+
+/**
+ * @brief Saturates the results of the integer operations that overflow at the limits of the type
+ */
+struct saturate_on_overflow {
+  template<std::integral T>
+  [[nodiscard]] static constexpr T on_overflow(bool positive) noexcept
+  {
+    return positive ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+  }
+};
+
+/**
+ * @brief Throws `std::overflow_error` if an integer operation overflows
+ */
+struct throw_on_overflow {
+  template<std::integral T>
+  [[noreturn]] static constexpr T on_overflow(bool)
+  {
+    throw std::overflow_error("integer overflow");
+  }
+};
+
+template<typename P>
+concept OverflowPolicy = requires {
+  {
+    P::template on_overflow<int>(true)
+  } -> std::same_as<int>;
+};
+
+namespace detail {
+
+// `true` if `lhs op rhs` overflowed the range of `T`; `res` is the wrapped result then
+template<std::integral T, std::integral U>
+[[nodiscard]] constexpr bool add_overflow(T lhs, U rhs, T& res)
+{
+#if MP_UNITS_COMP_GCC || MP_UNITS_COMP_CLANG
+  return __builtin_add_overflow(lhs, rhs, &res);
+#else
+  using wide = std::intmax_t;
+  if constexpr (std::is_unsigned_v<T> && std::is_unsigned_v<U>) {
+    res = static_cast<T>(lhs + rhs);
+    return rhs > std::numeric_limits<T>::max() || res < lhs;
+  } else {
+    const wide r = static_cast<wide>(lhs) + static_cast<wide>(rhs);
+    res = static_cast<T>(r);
+    return !std::in_range<T>(r);
+  }
+#endif
+}
+
+template<std::integral T, std::integral U>
+[[nodiscard]] constexpr bool sub_overflow(T lhs, U rhs, T& res)
+{
+#if MP_UNITS_COMP_GCC || MP_UNITS_COMP_CLANG
+  return __builtin_sub_overflow(lhs, rhs, &res);
+#else
+  const std::intmax_t r = static_cast<std::intmax_t>(lhs) - static_cast<std::intmax_t>(rhs);
+  res = static_cast<T>(r);
+  return !std::in_range<T>(r);
+#endif
+}
+
+template<std::integral T, std::integral U>
+[[nodiscard]] constexpr bool mul_overflow(T lhs, U rhs, T& res)
+{
+#if MP_UNITS_COMP_GCC || MP_UNITS_COMP_CLANG
+  return __builtin_mul_overflow(lhs, rhs, &res);
+#else
+  if constexpr (sizeof(T) < sizeof(std::intmax_t) && sizeof(U) < sizeof(std::intmax_t)) {
+    const std::intmax_t r = static_cast<std::intmax_t>(lhs) * static_cast<std::intmax_t>(rhs);
+    res = static_cast<T>(r);
+    return !std::in_range<T>(r);
+  } else {
+    res = static_cast<T>(lhs * rhs);
+    return lhs != 0 && (res / lhs != rhs || !std::in_range<T>(rhs) ||
+                        (lhs == -1 && rhs == std::numeric_limits<T>::min()));
+  }
+#endif
+}
+
+template<std::integral T>
+[[nodiscard]] constexpr bool is_negative(T v)
+{
+  if constexpr (std::is_signed_v<T>)
+    return v < 0;
+  else
+    return false;
+}
+
+// the magnitude of `v` (also of the smallest value of a signed type)
+template<std::integral T>
+[[nodiscard]] constexpr std::make_unsigned_t<T> unsigned_abs(T v)
+{
+  using U = std::make_unsigned_t<T>;
+  return is_negative(v) ? static_cast<U>(U{0} - static_cast<U>(v)) : static_cast<U>(v);
+}
+
+// `-magnitude` for a magnitude not larger than the one of the smallest value of `T`
+template<std::integral T, std::unsigned_integral U>
+[[nodiscard]] constexpr T negate(U magnitude)
+{
+  using UT = std::make_unsigned_t<T>;
+  return static_cast<T>(static_cast<UT>(UT{0} - static_cast<UT>(magnitude)));
+}
+
+}  // namespace detail
+
+/**
+ * @brief An integer that handles the overflows of its operations with a policy
+ *
+ * Use the `saturating<T>` and `checked<T>` aliases as representation types of quantities to prevent the silent
+ * wraparound of the values (i.e. `quantity<si::metre, saturating<std::int16_t>>`). The overflows of the
+ * arithmetic operations are detected with the compiler built-ins (a single flag test after the operation) and
+ * handled by `Policy`. Conversions from other integral and floating-point values and the conversions of
+ * quantities between units are checked as well.
+ *
+ * @tparam T the underlying integral type
+ * @tparam Policy the overflow handling policy
+ */
+template<std::integral T, OverflowPolicy Policy>
+  requires(!is_same_v<T, bool>)
+class overflow_checked_integer {
+  T value_{};
+
+  template<std::integral U>
+  [[nodiscard]] static constexpr T convert(U v)
+  {
+    if (!std::in_range<T>(v)) [[unlikely]]
+      return Policy::template on_overflow<T>(v > 0);
+    return static_cast<T>(v);
+  }
+
+  template<std::floating_point U>
+  [[nodiscard]] static constexpr T convert(U v)
+  {
+    // NaN compares false with everything and is handled as an overflow too
+    constexpr U lower = static_cast<U>(std::numeric_limits<T>::min()) - 1;
+    constexpr U upper = static_cast<U>(std::numeric_limits<T>::max()) + 1;
+    if (!(v > lower && v < upper)) [[unlikely]]
+      return Policy::template on_overflow<T>(v > 0);
+    return static_cast<T>(v);
+  }
+
+public:
+  using underlying_type = T;
+  using policy = Policy;
+
+  overflow_checked_integer() = default;
+
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  constexpr explicit(!std::in_range<T>(std::numeric_limits<U>::min()) ||
+                     !std::in_range<T>(std::numeric_limits<U>::max())) overflow_checked_integer(U v) :
+      value_(convert(v))
+  {
+  }
+
+  // truncates towards zero
+  template<std::floating_point U>
+  constexpr explicit overflow_checked_integer(U v) : value_(convert(v))
+  {
+  }
+
+  template<std::integral U, OverflowPolicy P>
+  constexpr explicit overflow_checked_integer(const overflow_checked_integer<U, P>& v) : value_(convert(v.value()))
+  {
+  }
+
+  [[nodiscard]] constexpr T value() const { return value_; }
+
+  template<std::integral U>
+  [[nodiscard]] constexpr explicit operator U() const
+  {
+    return overflow_checked_integer<U, Policy>(value_).value();
+  }
+
+  template<std::floating_point U>
+  [[nodiscard]] constexpr explicit operator U() const
+  {
+    return static_cast<U>(value_);
+  }
+
+  [[nodiscard]] constexpr overflow_checked_integer operator+() const { return *this; }
+  [[nodiscard]] constexpr overflow_checked_integer operator-() const { return overflow_checked_integer{} - *this; }
+
+  template<std::integral U>
+  constexpr overflow_checked_integer& operator+=(U rhs)
+  {
+    if constexpr (is_same_v<Policy, saturate_on_overflow> && is_same_v<U, T>)
+      // branch-free, so the loops of additions can be vectorized
+      value_ = detail::simd::add_sat_scalar(value_, rhs);
+    else if (detail::add_overflow(value_, rhs, value_)) [[unlikely]]
+      value_ = Policy::template on_overflow<T>(rhs > 0);
+    return *this;
+  }
+
+  template<std::integral U>
+  constexpr overflow_checked_integer& operator-=(U rhs)
+  {
+    if (detail::sub_overflow(value_, rhs, value_)) [[unlikely]]
+      value_ = Policy::template on_overflow<T>(rhs < 0);
+    return *this;
+  }
+
+  template<std::integral U>
+  constexpr overflow_checked_integer& operator*=(U rhs)
+  {
+    const bool positive = (value_ < 0) == (rhs < 0);
+    if (detail::mul_overflow(value_, rhs, value_)) [[unlikely]]
+      value_ = Policy::template on_overflow<T>(positive);
+    return *this;
+  }
+
+  // the division by zero is undefined as for the built-in integral types
+  template<std::integral U>
+  constexpr overflow_checked_integer& operator/=(U rhs)
+  {
+    if constexpr (std::is_signed_v<T> == std::is_signed_v<U>) {
+      if constexpr (std::is_signed_v<U>)
+        if (rhs == -1) return *this *= rhs;  // `min / -1`
+      value_ = convert(value_ / rhs);
+    } else {
+      // the usual arithmetic conversions would make the signed operand unsigned, so the magnitudes are divided
+      const auto quotient = detail::unsigned_abs(value_) / detail::unsigned_abs(rhs);
+      if (detail::is_negative(value_) == detail::is_negative(rhs))
+        value_ = static_cast<T>(quotient);
+      else if constexpr (std::is_signed_v<T>)
+        value_ = detail::negate<T>(quotient);
+      else if (quotient != 0) [[unlikely]]
+        value_ = Policy::template on_overflow<T>(false);
+      else
+        value_ = 0;
+    }
+    return *this;
+  }
+
+  template<std::integral U>
+  constexpr overflow_checked_integer& operator%=(U rhs)
+  {
+    if constexpr (std::is_signed_v<T> == std::is_signed_v<U>) {
+      if constexpr (std::is_signed_v<U>)
+        if (rhs == -1) rhs = 1;  // `min % -1`
+      value_ = static_cast<T>(value_ % rhs);
+    } else {
+      // the remainder has the sign of the dividend
+      const auto remainder = detail::unsigned_abs(value_) % detail::unsigned_abs(rhs);
+      value_ = detail::is_negative(value_) ? detail::negate<T>(remainder) : static_cast<T>(remainder);
+    }
+    return *this;
+  }
+
+  constexpr overflow_checked_integer& operator+=(const overflow_checked_integer& rhs) { return *this += rhs.value_; }
+  constexpr overflow_checked_integer& operator-=(const overflow_checked_integer& rhs) { return *this -= rhs.value_; }
+  constexpr overflow_checked_integer& operator*=(const overflow_checked_integer& rhs) { return *this *= rhs.value_; }
+  constexpr overflow_checked_integer& operator/=(const overflow_checked_integer& rhs) { return *this /= rhs.value_; }
+  constexpr overflow_checked_integer& operator%=(const overflow_checked_integer& rhs) { return *this %= rhs.value_; }
+
+  [[nodiscard]] friend constexpr overflow_checked_integer operator+(overflow_checked_integer lhs,
+                                                                   const overflow_checked_integer& rhs)
+  {
+    return lhs += rhs;
+  }
+
+  [[nodiscard]] friend constexpr overflow_checked_integer operator-(overflow_checked_integer lhs,
+                                                                   const overflow_checked_integer& rhs)
+  {
+    return lhs -= rhs;
+  }
+
+  [[nodiscard]] friend constexpr overflow_checked_integer operator*(overflow_checked_integer lhs,
+                                                                   const overflow_checked_integer& rhs)
+  {
+    return lhs *= rhs;
+  }
+
+  [[nodiscard]] friend constexpr overflow_checked_integer operator/(overflow_checked_integer lhs,
+                                                                   const overflow_checked_integer& rhs)
+  {
+    return lhs /= rhs;
+  }
+
+  [[nodiscard]] friend constexpr overflow_checked_integer operator%(overflow_checked_integer lhs,
+                                                                   const overflow_checked_integer& rhs)
+  {
+    return lhs %= rhs;
+  }
+
+  // the scaling by any integer is checked in the infinite precision (i.e. `saturating<std::int16_t>` by `100'000`)
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  [[nodiscard]] friend constexpr overflow_checked_integer operator*(overflow_checked_integer lhs, U rhs)
+  {
+    return lhs *= rhs;
+  }
+
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  [[nodiscard]] friend constexpr overflow_checked_integer operator*(U lhs, overflow_checked_integer rhs)
+  {
+    return rhs *= lhs;
+  }
+
+  template<std::integral U>
+    requires(!is_same_v<U, bool>)
+  [[nodiscard]] friend constexpr overflow_checked_integer operator/(overflow_checked_integer lhs, U rhs)
+  {
+    return lhs /= rhs;
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const overflow_checked_integer&,
+                                                 const overflow_checked_integer&) = default;
+  [[nodiscard]] friend constexpr auto operator<=>(const overflow_checked_integer&,
+                                                  const overflow_checked_integer&) = default;
+};
+
+/**
+ * @brief An integer saturating the results of its operations at the limits of `T` instead of wrapping around
+ */
+template<std::integral T>
+using saturating = overflow_checked_integer<T, saturate_on_overflow>;
+
+/**
+ * @brief An integer throwing `std::overflow_error` when the result of its operation is not representable in `T`
+ */
+template<std::integral T>
+using checked = overflow_checked_integer<T, throw_on_overflow>;
+
+namespace detail {
+
+template<typename T>
+inline constexpr bool is_overflow_checked_integer = false;
+
+template<typename T, typename P>
+inline constexpr bool is_overflow_checked_integer<overflow_checked_integer<T, P>> = true;
+
+template<typename T>
+[[nodiscard]] constexpr auto underlying_integer(const T& v)
+{
+  if constexpr (is_overflow_checked_integer<T>)
+    return v.value();
+  else
+    return v;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Scales overflow-checked integers in the conversions between units
+ *
+ * Uses the overflow-free integral scaling of `sudo_cast` followed by a single range check of the result if any
+ * value of the source type multiplied by the numerator of the magnitude fits in `std::intmax_t`. Otherwise, the
+ * scaling checks every step (`checked_sudo_cast`). Values scaled by irrational magnitudes are computed in
+ * `long double` and then checked. The result is truncated towards zero.
+ */
+template<typename From, typename To>
+  requires detail::is_overflow_checked_integer<To> &&
+           (detail::is_overflow_checked_integer<From> || (std::integral<From> && !is_same_v<From, bool>))
+struct scaling_traits<From, To> {
+  template<Magnitude auto M>
+  [[nodiscard]] static constexpr To scale(const From& v)
+  {
+    using from_type = decltype(detail::underlying_integer(v));
+    using to_type = MP_UNITS_TYPENAME To::underlying_type;
+    const from_type value = detail::underlying_integer(v);
+    if constexpr (is_rational(M) && requires { detail::checked_scale_integral<M, to_type>(value); }) {
+      constexpr auto num = static_cast<std::uintmax_t>(get_value<std::intmax_t>(numerator(M)));
+      if constexpr (detail::max_abs_product<from_type, num>() <=
+                    static_cast<std::uintmax_t>(std::numeric_limits<std::intmax_t>::max())) {
+        const auto res = detail::scale_integral<M, from_type>(value);
+        if (!std::in_range<to_type>(res)) [[unlikely]]
+          return To(To::policy::template on_overflow<to_type>(res > 0));
+        return To(static_cast<to_type>(res));
+      } else {
+        if (const auto res = detail::checked_scale_integral<M, to_type>(value)) return To(*res);
+        return To(To::policy::template on_overflow<to_type>(value > 0));
+      }
+    } else
+      return To(static_cast<long double>(value) * get_value<long double>(M));
+  }
+};
+
+template<typename T, typename P>
+inline constexpr bool is_scalar<overflow_checked_integer<T, P>> = true;
+
+template<typename T, typename P>
+struct quantity_values<overflow_checked_integer<T, P>> {
+  static constexpr overflow_checked_integer<T, P> zero() noexcept { return overflow_checked_integer<T, P>{}; }
+  static constexpr overflow_checked_integer<T, P> one() noexcept { return overflow_checked_integer<T, P>(T{1}); }
+  static constexpr overflow_checked_integer<T, P> min() noexcept
+  {
+    return overflow_checked_integer<T, P>(std::numeric_limits<T>::lowest());
+  }
+  static constexpr overflow_checked_integer<T, P> max() noexcept
+  {
+    return overflow_checked_integer<T, P>(std::numeric_limits<T>::max());
+  }
+};
+
+/**
+ * @brief Adds two spans of quantities with `saturating` representation types element-wise
+ *
+ * Gives the same results as `lhs[i] + rhs[i]`. 8- and 16-bit integers are added with the saturating SIMD
+ * instructions and the wider ones with a branch-free loop. `out` may view the same buffer as one of the inputs,
+ * otherwise the buffers should not overlap.
+ */
+template<QuantitySpan S1, QuantitySpan S2, QuantitySpan Out>
+  requires(S1::reference == S2::reference) && (S1::reference == Out::reference) &&
+          is_same_v<typename S1::rep, typename S2::rep> && is_same_v<typename S1::rep, typename Out::rep> &&
+          (!std::is_const_v<typename Out::element_type>) &&
+          requires { typename S1::rep::underlying_type; } &&
+          is_same_v<typename S1::rep, saturating<typename S1::rep::underlying_type>>
+void add_sat(S1 lhs, S2 rhs, Out out)
+{
+  using rep = MP_UNITS_TYPENAME S1::rep;
+  using underlying = MP_UNITS_TYPENAME rep::underlying_type;
+  static_assert(sizeof(rep) == sizeof(underlying) && std::is_standard_layout_v<rep>);
+  gsl_Expects(lhs.size() == rhs.size() && lhs.size() == out.size());
+  detail::simd::add_sat(reinterpret_cast<const underlying*>(lhs.data()),
+                        reinterpret_cast<const underlying*>(rhs.data()), lhs.size(),
+                        reinterpret_cast<underlying*>(out.data()));
+}
+
+}  // namespace mp_units
+
+// the common types of overflow-checked integers with the built-in types and with each other
+template<typename T, typename P, std::integral U>
+  requires(!mp_units::is_same_v<U, bool>)
+struct std::common_type<mp_units::overflow_checked_integer<T, P>, U> {
+  using type = mp_units::overflow_checked_integer<T, P>;
+};
+
+template<typename T, typename P, std::integral U>
+  requires(!mp_units::is_same_v<U, bool>)
+struct std::common_type<U, mp_units::overflow_checked_integer<T, P>> {
+  using type = mp_units::overflow_checked_integer<T, P>;
+};
+
+template<typename T, typename P, std::floating_point U>
+struct std::common_type<mp_units::overflow_checked_integer<T, P>, U> {
+  using type = U;
+};
+
+template<typename T, typename P, std::floating_point U>
+struct std::common_type<U, mp_units::overflow_checked_integer<T, P>> {
+  using type = U;
+};
+
+template<typename T1, typename T2, typename P>
+struct std::common_type<mp_units::overflow_checked_integer<T1, P>, mp_units::overflow_checked_integer<T2, P>> {
+  using type = mp_units::overflow_checked_integer<std::common_type_t<T1, T2>, P>;
+};
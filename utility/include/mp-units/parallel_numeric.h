@@ -0,0 +1,241 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// The reductions of `mp-units/numeric.h` taking an execution policy.
+//
+// This header is separate as with libstdc++ the parallel algorithms are implemented with TBB, so its users have to
+// link to TBB (i.e. `TBB::tbb`) even if only the sequenced policies are used.
+
+#include <mp-units/numeric.h>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<execution>)
+#include <execution>
+#endif
+
+#ifdef __cpp_lib_execution
+
+namespace mp_units {
+
+namespace detail {
+
+template<typename T>
+concept ExecutionPolicy = std::is_execution_policy_v<std::remove_cvref_t<T>>;
+
+// the accumulators reduced in parallel; `pairwise` and `kahan` use the `neumaier` one as
+// the parallel reduction does not preserve the order of the additions anyway
+template<summation Mode, typename T>
+using parallel_accumulator_for = std::conditional_t<Mode == summation::naive, naive_sum<T>, simd::neumaier_sum<T>>;
+
+template<summation Mode, typename T, typename Policy, typename It, typename Proj>
+[[nodiscard]] T parallel_reduce(Policy&& policy, It first, It last, Proj proj)
+{
+  using acc = parallel_accumulator_for<Mode, T>;
+  return std::transform_reduce(
+           std::forward<Policy>(policy), first, last, acc{},
+           [](acc lhs, const acc& rhs) {
+             lhs.merge(rhs);
+             return lhs;
+           },
+           [&](const auto& v) {
+             acc a;
+             a.add(static_cast<T>(proj(v)));
+             return a;
+           })
+    .result();
+}
+
+/**
+ * @brief An iterator over the indices with the random-access category
+ *
+ * The parallel algorithms require the Cpp17ForwardIterator category which the iterators of `std::views::iota` do not
+ * have (libstdc++ runs the algorithms serially for them).
+ */
+class index_iterator {
+  std::size_t index_ = 0;
+
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const std::size_t*;
+  using reference = std::size_t;
+
+  index_iterator() = default;
+  constexpr explicit index_iterator(std::size_t index) : index_(index) {}
+
+  [[nodiscard]] constexpr std::size_t operator*() const { return index_; }
+  [[nodiscard]] constexpr std::size_t operator[](difference_type n) const
+  {
+    return index_ + static_cast<std::size_t>(n);
+  }
+
+  constexpr index_iterator& operator++()
+  {
+    ++index_;
+    return *this;
+  }
+  constexpr index_iterator operator++(int) { return index_iterator(index_++); }
+  constexpr index_iterator& operator--()
+  {
+    --index_;
+    return *this;
+  }
+  constexpr index_iterator operator--(int) { return index_iterator(index_--); }
+
+  constexpr index_iterator& operator+=(difference_type n)
+  {
+    index_ += static_cast<std::size_t>(n);
+    return *this;
+  }
+  constexpr index_iterator& operator-=(difference_type n)
+  {
+    index_ -= static_cast<std::size_t>(n);
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr index_iterator operator+(index_iterator it, difference_type n) { return it += n; }
+  [[nodiscard]] friend constexpr index_iterator operator+(difference_type n, index_iterator it) { return it += n; }
+  [[nodiscard]] friend constexpr index_iterator operator-(index_iterator it, difference_type n) { return it -= n; }
+  [[nodiscard]] friend constexpr difference_type operator-(index_iterator lhs, index_iterator rhs)
+  {
+    return static_cast<difference_type>(lhs.index_ - rhs.index_);
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(index_iterator, index_iterator) = default;
+  [[nodiscard]] friend constexpr auto operator<=>(index_iterator, index_iterator) = default;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Computes the sum of all quantities in a range in parallel
+ *
+ * `summation::kahan` and `summation::pairwise` are computed with `summation::neumaier` as the parallel reduction
+ * does not preserve the order of the additions. With libstdc++ the parallel algorithms require linking to TBB.
+ *
+ * @param policy execution policy
+ * @param r random access range of quantities
+ */
+template<summation Mode = summation::neumaier, detail::ExecutionPolicy Policy, detail::QuantityRange R>
+[[nodiscard]] std::ranges::range_value_t<R> sum(Policy&& policy, R&& r)
+{
+  using Q = std::ranges::range_value_t<R>;
+  if constexpr (detail::ContiguousNumericalValues<R>) {
+    auto values = r.numerical_values();
+    return make_quantity<Q::reference>(detail::parallel_reduce<Mode, typename Q::rep>(
+      std::forward<Policy>(policy), std::ranges::begin(values), std::ranges::end(values), std::identity{}));
+  } else
+    return make_quantity<Q::reference>(detail::parallel_reduce<Mode, typename Q::rep>(
+      std::forward<Policy>(policy), std::ranges::begin(r), std::ranges::end(r),
+      [](const Q& q) { return q.numerical_value(); }));
+}
+
+/**
+ * @brief Computes the arithmetic mean of all quantities in a range in parallel
+ *
+ * @param policy execution policy
+ * @param r non-empty random access range of quantities
+ */
+template<summation Mode = summation::neumaier, detail::ExecutionPolicy Policy, detail::QuantityRange R>
+[[nodiscard]] std::ranges::range_value_t<R> mean(Policy&& policy, R&& r)
+{
+  using rep = typename std::ranges::range_value_t<R>::rep;
+  gsl_Expects(!std::ranges::empty(r));
+  return sum<Mode>(std::forward<Policy>(policy), r) / static_cast<rep>(std::ranges::size(r));
+}
+
+/**
+ * @brief Computes the sum of the products of the corresponding quantities from two ranges in parallel
+ *
+ * @param policy execution policy
+ * @param r1 random access range of quantities
+ * @param r2 random access range of quantities of the same size as `r1`
+ */
+template<summation Mode = summation::neumaier, detail::ExecutionPolicy Policy, detail::QuantityRange R1,
+         detail::QuantityRange R2>
+  requires requires(std::ranges::range_value_t<R1> q1, std::ranges::range_value_t<R2> q2) { q1* q2; }
+[[nodiscard]] Quantity auto dot(Policy&& policy, R1&& r1, R2&& r2)
+{
+  using ret = decltype(std::declval<std::ranges::range_value_t<R1>>() * std::declval<std::ranges::range_value_t<R2>>());
+  using rep = MP_UNITS_TYPENAME ret::rep;
+  using acc = detail::parallel_accumulator_for<Mode, rep>;
+  gsl_Expects(std::ranges::size(r1) == std::ranges::size(r2));
+  const auto merge = [](acc lhs, const acc& rhs) {
+    lhs.merge(rhs);
+    return lhs;
+  };
+  const auto product = [](const auto& v1, const auto& v2) {
+    acc a;
+    a.add(static_cast<rep>(v1 * v2));
+    return a;
+  };
+  if constexpr (detail::ContiguousNumericalValues<R1> && detail::ContiguousNumericalValues<R2>) {
+    // the numerical values of both ranges are zipped directly
+    const auto* first1 = std::ranges::data(r1.numerical_values());
+    const auto* first2 = std::ranges::data(r2.numerical_values());
+    const auto n = static_cast<std::ptrdiff_t>(std::ranges::size(r1));
+    return make_quantity<ret::reference>(
+      std::transform_reduce(std::forward<Policy>(policy), first1, first1 + n, first2, acc{}, merge, product).result());
+  } else {
+    auto get1 = detail::numerical_value_getter(r1);
+    auto get2 = detail::numerical_value_getter(r2);
+    const detail::index_iterator first{0};
+    const detail::index_iterator last{static_cast<std::size_t>(std::ranges::size(r1))};
+    return make_quantity<ret::reference>(std::transform_reduce(std::forward<Policy>(policy), first, last, acc{}, merge,
+                                                               [&](std::size_t i) { return product(get1(i), get2(i)); })
+                                           .result());
+  }
+}
+
+/**
+ * @brief Finds the smallest and the largest quantity in a range in parallel
+ *
+ * @param policy execution policy
+ * @param r non-empty random access range of quantities
+ */
+template<detail::ExecutionPolicy Policy, detail::QuantityRange R>
+[[nodiscard]] std::ranges::min_max_result<std::ranges::range_value_t<R>> min_max(Policy&& policy, R&& r)
+{
+  gsl_Expects(!std::ranges::empty(r));
+  if constexpr (detail::ContiguousNumericalValues<R>) {
+    using Q = std::ranges::range_value_t<R>;
+    auto values = r.numerical_values();
+    const auto [min, max] = std::minmax_element(std::forward<Policy>(policy), values.begin(), values.end());
+    return {make_quantity<Q::reference>(*min), make_quantity<Q::reference>(*max)};
+  } else {
+    const auto [min, max] = std::minmax_element(std::forward<Policy>(policy), std::ranges::begin(r), std::ranges::end(r));
+    return {*min, *max};
+  }
+}
+
+}  // namespace mp_units
+
+#endif
@@ -0,0 +1,243 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 Mateusz Pusz
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <mp-units/quantity_point.h>
+#include <mp-units/systems/hep/hep.h>
+#include <mp-units/systems/iau/iau.h>
+#include <mp-units/systems/iec80000/iec80000.h>
+#include <mp-units/systems/imperial/imperial.h>
+#include <mp-units/systems/international/international.h>
+#include <mp-units/systems/si/from_chars.h>
+#include <mp-units/systems/si/point_origins.h>
+#include <mp-units/systems/usc/usc.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace mp_units {
+
+/**
+ * @brief A unit found in a `unit_registry`
+ *
+ * `origin` is the zero of the scale of the unit measured from the absolute point origin in the coherent SI unit
+ * (i.e. `273.15` for `°C`), and `0` for the units that are not registered with a point origin.
+ */
+struct registered_unit {
+  std::string_view symbol;
+  si::runtime_unit unit;
+  long double origin = 0;
+
+  [[nodiscard]] friend constexpr bool operator==(const registered_unit&, const registered_unit&) = default;
+};
+
+/**
+ * @brief Registers a unit together with the point origin of its scale (i.e. `°C` with the ice point)
+ */
+template<Unit auto U, PointOrigin auto PO>
+struct unit_with_origin {};
+
+/**
+ * @brief A set of unit symbols known at runtime
+ *
+ * Built at compile time into a minimal perfect hash table, so there is no initialization at startup and
+ * no allocation. A lookup of a symbol hashes its characters once and compares it with a single candidate.
+ */
+template<std::size_t N>
+class unit_registry {
+  detail::unit_symbol_table<registered_unit, N> table_;
+
+public:
+  consteval explicit unit_registry(const std::array<registered_unit, N>& units) : table_(units) {}
+
+  [[nodiscard]] static constexpr std::size_t size() { return N; }
+  [[nodiscard]] constexpr auto begin() const { return table_.begin(); }
+  [[nodiscard]] constexpr auto end() const { return table_.end(); }
+
+  /**
+   * @brief Finds a single unit symbol (i.e. "km", "°F", "GiB")
+   *
+   * @return A pointer to the registered unit or `nullptr` if the symbol is not registered
+   */
+  [[nodiscard]] constexpr const registered_unit* find(std::string_view symbol) const { return table_.find(symbol); }
+
+  /**
+   * @brief Parses a unit symbol expression (i.e. "mi/h", "kW h", "kg m⁻¹ s⁻²")
+   *
+   * Uses the grammar of `si::unit_from_chars`. The origin is kept only for a single symbol; the `symbol` of
+   * the result refers to the parsed characters for the expressions that are not a single symbol.
+   */
+  std::from_chars_result from_chars(const char* first, const char* last, registered_unit& unit) const
+  {
+    si::runtime_unit res;
+    const auto parsed = detail::unit_from_chars(table_, first, last, res);
+    if (parsed.ec != std::errc{}) return parsed;
+    const std::string_view text(first, static_cast<std::size_t>(parsed.ptr - first));
+    if (const registered_unit* single = find(text))
+      unit = *single;
+    else
+      unit = {text, res};
+    return parsed;
+  }
+};
+
+namespace detail {
+
+template<auto U>
+[[nodiscard]] consteval std::pair<si::runtime_unit, long double> registered_unit_value()
+{
+  if constexpr (Unit<decltype(U)>)
+    return {to_runtime_unit<U>(), 0};
+  else
+    return []<auto V, auto PO>(unit_with_origin<V, PO>) {
+      if constexpr (RelativePointOrigin<decltype(PO)>) {
+        constexpr auto q = PO.quantity_point - PO.absolute_point_origin;
+        return std::pair{to_runtime_unit<V>(), magnitude_value(get_canonical_unit(q.unit).mag) *
+                                                 static_cast<long double>(q.numerical_value())};
+      } else
+        return std::pair{to_runtime_unit<V>(), 0.0L};
+    }(U);
+}
+
+template<auto U>
+[[nodiscard]] consteval Unit auto registered_unit_of()
+{
+  if constexpr (Unit<decltype(U)>)
+    return U;
+  else
+    return []<auto V, auto PO>(unit_with_origin<V, PO>) { return V; }(U);
+}
+
+template<std::size_t N, auto... Us>
+consteval void append_registered_units(std::array<registered_unit, N>& all, std::size_t& count, unit_list<Us...>)
+{
+  ((all[count++] = registered_unit{unit_symbol_view<registered_unit_of<Us>(), text_encoding::unicode>(),
+                                   registered_unit_value<Us>().first, registered_unit_value<Us>().second}),
+   ...);
+  ((all[count++] = registered_unit{unit_symbol_view<registered_unit_of<Us>(), text_encoding::ascii>(),
+                                   registered_unit_value<Us>().first, registered_unit_value<Us>().second}),
+   ...);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Builds a `unit_registry` from lists of units in the order of their priority
+ *
+ * Both the Unicode and ASCII symbols of every unit are registered. If the same symbol is used by several units
+ * (i.e. "gal" in `usc` and `imperial`), the one from the earlier list wins.
+ *
+ * @tparam Lists `detail::unit_list` of units or `unit_with_origin`
+ */
+template<auto... Lists>
+[[nodiscard]] consteval auto make_unit_registry()
+{
+  constexpr std::size_t total = (0 + ... + (2 * Lists.size));
+  constexpr auto entries = []() consteval {
+    std::array<registered_unit, total> all{};
+    std::size_t count = 0;
+    (detail::append_registered_units(all, count, Lists), ...);
+    // `std::stable_sort` is not `constexpr`; the position breaks the ties to keep the first of the duplicates
+    std::array<std::size_t, total> order{};
+    for (std::size_t i = 0; i < total; ++i) order[i] = i;
+    std::ranges::sort(order, [&](std::size_t lhs, std::size_t rhs) {
+      return all[lhs].symbol < all[rhs].symbol || (all[lhs].symbol == all[rhs].symbol && lhs < rhs);
+    });
+    std::array<registered_unit, total> sorted{};
+    count = 0;
+    for (std::size_t i : order)
+      if (count == 0 || sorted[count - 1].symbol != all[i].symbol) sorted[count++] = all[i];
+    return std::pair{sorted, count};
+  }();
+  std::array<registered_unit, entries.second> unique{};
+  std::ranges::copy_n(entries.first.begin(), entries.second, unique.begin());
+  return unit_registry<entries.second>(unique);
+}
+
+namespace detail::registry_symbols {
+
+// the temperature units with the origins of their scales
+inline constexpr unit_list<unit_with_origin<si::kelvin, si::absolute_zero>{},
+                           unit_with_origin<si::degree_Celsius, si::ice_point>{},
+                           unit_with_origin<usc::degree_Fahrenheit, usc::zeroth_degree_Fahrenheit>{}>
+  temperatures;
+
+inline constexpr unit_list<international::pound, international::ounce, international::dram, international::grain,
+                           international::yard, international::foot, international::inch, international::pica,
+                           international::point, international::mile, international::league,
+                           international::nautical_mile, international::knot, international::mil, international::twip,
+                           international::poundal, international::pound_force, international::kip, international::psi,
+                           international::mechanical_horsepower>
+  international_units;
+
+inline constexpr unit_list<usc::fathom, usc::cable, usc::link, usc::rod, usc::chain, usc::furlong, usc::league,
+                           usc::gallon, usc::pottle, usc::quart, usc::pint, usc::cup, usc::gill, usc::fluid_ounce,
+                           usc::tablespoon, usc::shot, usc::teaspoon, usc::minim, usc::fluid_dram, usc::barrel,
+                           usc::dry_barrel, usc::bushel, usc::peck, usc::dry_gallon, usc::dry_quart, usc::dry_pint,
+                           usc::quarter, usc::short_hundredweight, usc::ton, usc::pennyweight, usc::troy_once,
+                           usc::troy_pound, usc::inch_of_mercury>
+  usc_units;
+
+inline constexpr unit_list<imperial::hand, imperial::barleycorn, imperial::thou, imperial::chain, imperial::furlong,
+                           imperial::cable, imperial::fathom, imperial::link, imperial::rod, imperial::gallon,
+                           imperial::quart, imperial::pint, imperial::gill, imperial::fluid_ounce, imperial::stone,
+                           imperial::quarter, imperial::long_hundredweight, imperial::long_ton>
+  imperial_units;
+
+using namespace iec80000::unit_symbols;
+
+inline constexpr unit_list<iec80000::bit, kbit, Mbit, Gbit, Tbit, Pbit, Ebit, Zbit, Ybit, Rbit, Qbit, Kibit, Mibit,
+                           Gibit, Tibit, Pibit, Eibit, o, ko, Mo, Go, To, Po, Eo, Zo, Yo, Ro, Qo, Kio, Mio, Gio, Tio,
+                           Pio, Eio, B, kB, MB, GB, TB, PB, EB, ZB, YB, RB, QB, KiB, MiB, GiB, TiB, PiB, EiB, Bd, kBd,
+                           MBd, GBd, TBd, PBd, EBd, ZBd, YBd, RBd, QBd>
+  iec80000_units;
+
+using namespace hep::unit_symbols;
+
+inline constexpr unit_list<qeV, reV, yeV, zeV, aeV, feV, peV, neV, ueV, meV, ceV, deV, daeV, heV, keV, MeV, GeV, TeV,
+                           PeV, EeV, ZeV, YeV, ReV, QeV, qb, rb, yb, zb, ab, fb, pb, nb, ub, mb, hep::barn>
+  hep_units;
+
+inline constexpr unit_list<iau::day, iau::Julian_year, iau::solar_mass, iau::Jupiter_mass, iau::Earth_mass,
+                           iau::astronomical_unit, iau::lunar_distance, iau::light_year, iau::parsec, iau::angstrom>
+  iau_units;
+
+}  // namespace detail::registry_symbols
+
+/**
+ * @brief The units of the SI, international, USC, imperial, IEC 80000, HEP, and IAU systems
+ *
+ * The physical constants defined as units (i.e. `c` or `m_e`) are not registered. For the symbols shared by
+ * several systems the unit of the earlier system in the above order is registered (i.e. "a" is an are, "t" is
+ * a tonne, and "gal" is a US gallon).
+ */
+inline constexpr auto default_unit_registry =
+  make_unit_registry<detail::registry_symbols::temperatures, detail::si_symbols::units,
+                     detail::registry_symbols::international_units, detail::registry_symbols::usc_units,
+                     detail::registry_symbols::imperial_units, detail::registry_symbols::iec80000_units,
+                     detail::registry_symbols::hep_units, detail::registry_symbols::iau_units>();
+
+}  // namespace mp_units